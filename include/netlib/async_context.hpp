@@ -0,0 +1,502 @@
+#ifndef NETLIB_ASYNC_CONTEXT_HPP
+#define NETLIB_ASYNC_CONTEXT_HPP
+
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+
+#include <coroutine>
+#include <exception>
+#include <unordered_map>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include "socket_poller.hpp"
+#include "unencrypted_tcp_client_socket.hpp"
+#include "unencrypted_tcp_server_socket.hpp"
+#include "unencrypted_udp_socket.hpp"
+#include "unencrypted_udp_client_socket.hpp"
+#include "ssl_tcp_client_socket.hpp"
+#include "ssl_tcp_server_socket.hpp"
+#include "task.hpp"
+
+
+namespace netlib {
+
+
+    /**
+     * Coroutine support over a socket poller.
+     * Its operations return awaitables; awaiting one performs the operation as far as possible without waiting,
+     * then suspends the coroutine until the socket poller reports the socket as ready,
+     * and resumes the coroutine, from the thread that polls, when the operation completes.
+     * The awaitables live in the frame of the awaiting coroutine, and the sockets stay registered
+     * to the socket poller in one-shot mode between operations, so as that awaiting does not allocate.
+     * A socket may have one pending operation per event type.
+     * Tcp sockets are non-blocking, and use the non-blocking operations, which keep the partially received
+     * and sent messages between steps, so as that a slow or stalled peer does not block the thread that polls;
+     * the sockets accepted and connected by the context are made non-blocking.
+     * Operations over udp sockets wait until the socket is ready, then invoke the operation of the socket,
+     * which transfers a whole datagram.
+     * Thread-safe class.
+     */
+    class async_context {
+    public:
+        using socket_ptr = socket_poller::socket_ptr;
+        using event_type = socket_poller::event_type;
+
+        /**
+         * Base class for awaitables.
+         */
+        class operation {
+        public:
+            /**
+             * The object is not copyable.
+             */
+            operation(const operation&) = delete;
+
+            /**
+             * The object is not copyable.
+             */
+            operation& operator = (const operation&) = delete;
+
+            /**
+             * Performs the operation; if complete, the coroutine is not suspended.
+             */
+            bool await_ready() {
+                return run();
+            }
+
+            /**
+             * Suspends the coroutine, until the socket the operation waits for is ready.
+             * @param h handle of the coroutine.
+             * @exception std::runtime_error thrown if the socket poller is full.
+             * @exception std::system_error thrown if the socket could not be registered.
+             */
+            void await_suspend(std::coroutine_handle<> h) {
+                m_handle = h;
+                m_context.wait(*this);
+            }
+
+            /**
+             * Checks if the socket of the operation is ready for the given event:
+             * either the socket poller reported it, or polling it without waiting does.
+             * @param e event type.
+             */
+            bool is_ready(event_type e) const;
+
+            /**
+             * Requests to wait for the socket of the operation to be ready.
+             * @param e event type.
+             * @return false, to be returned by the step function.
+             */
+            bool wait(event_type e) {
+                return wait(m_socket, e);
+            }
+
+            /**
+             * Requests to wait for the given socket to be ready.
+             * @param s socket.
+             * @param e event type.
+             * @return false, to be returned by the step function.
+             */
+            bool wait(const socket_ptr& s, event_type e) {
+                m_wait_socket = s;
+                m_wait_event = e;
+                return false;
+            }
+
+        protected:
+            /**
+             * Constructor.
+             * @param context context of the operation.
+             * @param s socket of the operation.
+             */
+            operation(async_context& context, const socket_ptr& s) : m_context(context), m_socket(s), m_wait_event(event_type::read), m_ready(false) {
+            }
+
+            /**
+             * Rethrows the exception of the operation, if any.
+             */
+            void rethrow_error() const {
+                if (m_error) {
+                    std::rethrow_exception(m_error);
+                }
+            }
+
+            /**
+             * Continues the operation.
+             * @return true if the operation is complete, false if it waits for a socket.
+             */
+            virtual bool step() = 0;
+
+        private:
+            async_context& m_context;
+            socket_ptr m_socket;
+            socket_ptr m_wait_socket;
+            event_type m_wait_event;
+            bool m_ready;
+            std::coroutine_handle<> m_handle;
+            std::exception_ptr m_error;
+
+            //continues the operation; an exception completes it
+            bool run();
+
+            //invoked when the socket the operation waits for is ready
+            void resume();
+
+            friend class async_context;
+        };
+
+        /**
+         * Awaitable with a step function.
+         * @param R type of result.
+         * @param F type of step function; signature: bool(operation&, R&).
+         */
+        template <class R, class F> class basic_operation : public operation {
+        public:
+            /**
+             * Constructor.
+             * @param context context of the operation.
+             * @param s socket of the operation.
+             * @param f step function.
+             */
+            basic_operation(async_context& context, const socket_ptr& s, F&& f) : operation(context, s), m_function(std::move(f)), m_result() {
+            }
+
+            /**
+             * Returns the result of the operation, or rethrows the exception of the operation.
+             */
+            R await_resume() {
+                rethrow_error();
+                return std::move(m_result);
+            }
+
+        private:
+            F m_function;
+            R m_result;
+
+            bool step() override {
+                return m_function(*this, m_result);
+            }
+        };
+
+        /**
+         * Constructor.
+         * @param poller socket poller that drives the operations; it shall be polled by another thread,
+         *  e.g. it can be a socket_poller_thread.
+         */
+        async_context(socket_poller& poller);
+
+        /**
+         * The object is not copyable.
+         */
+        async_context(const async_context&) = delete;
+
+        /**
+         * The object is not movable.
+         */
+        async_context(async_context&&) = delete;
+
+        /**
+         * Removes the registered sockets from the socket poller.
+         * No operation shall be pending.
+         */
+        ~async_context();
+
+        /**
+         * The object is not copyable.
+         */
+        async_context& operator = (const async_context&) = delete;
+
+        /**
+         * The object is not movable.
+         */
+        async_context& operator = (async_context&&) = delete;
+
+        /**
+         * Returns the socket poller.
+         */
+        socket_poller& poller() const {
+            return m_poller;
+        }
+
+        /**
+         * Removes a socket from the socket poller.
+         * The socket poller keeps the registered sockets open; it shall be invoked when a socket is no longer used.
+         * No operation shall be pending for the socket.
+         * @param s socket.
+         */
+        void remove(const socket_ptr& s);
+
+        /**
+         * Creates an awaitable from a step function.
+         * The step function performs the operation, as far as possible without blocking;
+         * if it needs to wait, it returns the result of operation::wait(), and it is invoked again when the socket is ready.
+         * @param s socket of the operation.
+         * @param f step function with signature bool(operation&, R&); it returns true when the operation is complete.
+         * @return the awaitable; the result of awaiting it is the result set by the step function.
+         */
+        template <class R, class F> basic_operation<R, F> make_operation(const socket_ptr& s, F&& f) {
+            return basic_operation<R, F>(*this, s, std::forward<F>(f));
+        }
+
+        /**
+         * Receives a message over a non-blocking unencrypted tcp socket.
+         * @param s socket.
+         * @param data reception buffer.
+         * @return awaitable that results in true on success, false if the socket is closed.
+         */
+        auto receive(const std::shared_ptr<unencrypted::tcp::client_socket>& s, std::vector<char>& data) {
+            return make_operation<bool>(s, [s = s.get(), &data](operation& op, bool& result) {
+                return complete(op, s->receive_non_blocking(data), result);
+                });
+        }
+
+        /**
+         * Sends a message over a non-blocking unencrypted tcp socket.
+         * @param s socket.
+         * @param data data to send; they must stay valid until the operation completes.
+         * @return awaitable that results in true on success, false if the socket is closed.
+         */
+        auto send(const std::shared_ptr<unencrypted::tcp::client_socket>& s, const std::vector<char>& data) {
+            return make_operation<bool>(s, [s = s.get(), &data, offset = size_t{0}](operation& op, bool& result) mutable {
+                return complete(op, s->send_non_blocking(data, offset), result);
+                });
+        }
+
+        /**
+         * Accepts a connection over an unencrypted tcp server socket.
+         * The client socket is non-blocking.
+         * @param s server socket.
+         * @param addr client address.
+         * @return awaitable that results in the client socket.
+         */
+        auto accept(const std::shared_ptr<unencrypted::tcp::server_socket>& s, socket_address& addr) {
+            return make_operation<std::shared_ptr<unencrypted::tcp::client_socket>>(s, [s = s.get(), &addr](operation& op, std::shared_ptr<unencrypted::tcp::client_socket>& result) {
+                if (!op.is_ready(event_type::read)) {
+                    return op.wait(event_type::read);
+                }
+                result = accept_connection(*s, addr);
+                return true;
+                });
+        }
+
+        /**
+         * Connects a new non-blocking unencrypted tcp client socket.
+         * @param server_addr address of server.
+         * @return awaitable that results in the connected socket.
+         * @exception std::system_error thrown if the socket could not be created, or the connection failed.
+         */
+        auto connect(const socket_address& server_addr) {
+            auto s = create_connecting_socket(server_addr);
+            return make_operation<std::shared_ptr<unencrypted::tcp::client_socket>>(s, [this, s](operation& op, std::shared_ptr<unencrypted::tcp::client_socket>& result) {
+                if (!continue_connect(op, s)) {
+                    return false;
+                }
+                result = s;
+                return true;
+                });
+        }
+
+        /**
+         * Sends a datagram over an unencrypted udp socket.
+         * @param s socket.
+         * @param data data to send; they must stay valid until the operation completes.
+         * @param receiver_addr receiver address; it must stay valid until the operation completes.
+         * @return awaitable that results in true on success, false if the socket is closed.
+         */
+        auto send_to(const std::shared_ptr<unencrypted::udp::socket>& s, const std::vector<char>& data, const socket_address& receiver_addr) {
+            return make_operation<bool>(s, [s = s.get(), &data, &receiver_addr](operation& op, bool& result) {
+                if (!op.is_ready(event_type::write)) {
+                    return op.wait(event_type::write);
+                }
+                result = s->send(data, receiver_addr);
+                return true;
+                });
+        }
+
+        /**
+         * Receives a datagram over an unencrypted udp socket.
+         * @param s socket.
+         * @param data reception buffer.
+         * @param sender_addr sender address.
+         * @param max_message_size max message size.
+         * @return awaitable that results in true on success, false if the socket is closed.
+         */
+        auto receive_from(const std::shared_ptr<unencrypted::udp::socket>& s, std::vector<char>& data, socket_address& sender_addr, const uint16_t max_message_size = NETLIB_UDP_MAX_MESSAGE_SIZE) {
+            return make_operation<bool>(s, [s = s.get(), &data, &sender_addr, max_message_size](operation& op, bool& result) {
+                if (!op.is_ready(event_type::read)) {
+                    return op.wait(event_type::read);
+                }
+                result = s->receive(data, sender_addr, max_message_size);
+                return true;
+                });
+        }
+
+        /**
+         * Sends a datagram over an unencrypted udp client socket.
+         * @param s socket.
+         * @param data data to send; they must stay valid until the operation completes.
+         * @return awaitable that results in true on success, false if the socket is closed.
+         */
+        auto send(const std::shared_ptr<unencrypted::udp::client_socket>& s, const std::vector<char>& data) {
+            return make_operation<bool>(s, [s = s.get(), &data](operation& op, bool& result) {
+                if (!op.is_ready(event_type::write)) {
+                    return op.wait(event_type::write);
+                }
+                result = s->send(data);
+                return true;
+                });
+        }
+
+        /**
+         * Receives a datagram over an unencrypted udp client socket.
+         * @param s socket.
+         * @param data reception buffer.
+         * @param max_message_size max message size.
+         * @return awaitable that results in true on success, false if the socket is closed.
+         */
+        auto receive(const std::shared_ptr<unencrypted::udp::client_socket>& s, std::vector<char>& data, const uint16_t max_message_size = NETLIB_UDP_MAX_MESSAGE_SIZE) {
+            return make_operation<bool>(s, [s = s.get(), &data, max_message_size](operation& op, bool& result) {
+                if (!op.is_ready(event_type::read)) {
+                    return op.wait(event_type::read);
+                }
+                result = s->receive(data, max_message_size);
+                return true;
+                });
+        }
+
+        /**
+         * Completes the handshake of a non-blocking ssl tcp socket.
+         * @param s socket.
+         * @return awaitable that results in true on success, false if the socket is closed.
+         */
+        auto handshake(const std::shared_ptr<ssl::tcp::client_socket>& s) {
+            return make_operation<bool>(s, [s = s.get()](operation& op, bool& result) {
+                return complete(op, s->handshake(), result);
+                });
+        }
+
+        /**
+         * Receives a message over a non-blocking ssl tcp socket.
+         * @param s socket.
+         * @param data reception buffer.
+         * @return awaitable that results in true on success, false if the socket is closed.
+         */
+        auto receive(const std::shared_ptr<ssl::tcp::client_socket>& s, std::vector<char>& data) {
+            return make_operation<bool>(s, [s = s.get(), &data](operation& op, bool& result) {
+                return complete(op, s->receive_non_blocking(data), result);
+                });
+        }
+
+        /**
+         * Sends a message over a non-blocking ssl tcp socket.
+         * @param s socket.
+         * @param data data to send.
+         * @return awaitable that results in true on success, false if the socket is closed.
+         */
+        auto send(const std::shared_ptr<ssl::tcp::client_socket>& s, const std::vector<char>& data) {
+            return make_operation<bool>(s, [s = s.get(), &data, queued = false](operation& op, bool& result) mutable {
+                if (queued) {
+                    return complete(op, s->flush(), result);
+                }
+                queued = true;
+                return complete(op, s->send_non_blocking(data), result);
+                });
+        }
+
+        /**
+         * Accepts a connection over an ssl tcp server socket, then completes the handshake.
+         * The client socket is non-blocking, and registered to the socket poller.
+         * @param s server socket.
+         * @param addr client address.
+         * @return awaitable that results in the client socket.
+         * @exception ssl::error thrown (when awaited) if the connection is closed during the handshake.
+         */
+        auto accept(const std::shared_ptr<ssl::tcp::server_socket>& s, socket_address& addr) {
+            return make_operation<std::shared_ptr<ssl::tcp::client_socket>>(s, [this, s = s.get(), &addr, client = std::shared_ptr<ssl::tcp::client_socket>()](operation& op, std::shared_ptr<ssl::tcp::client_socket>& result) mutable {
+                if (!client) {
+                    if (!op.is_ready(event_type::read)) {
+                        return op.wait(event_type::read);
+                    }
+                    client = s->accept(addr, true);
+                }
+                if (!continue_handshake(op, client)) {
+                    return false;
+                }
+                result = std::move(client);
+                return true;
+                });
+        }
+
+        /**
+         * Connects a new non-blocking ssl tcp client socket, then completes the handshake.
+         * @param context ssl context.
+         * @param server_addr address of server.
+         * @param server_name name of the server, for the server name indication extension; optional.
+         * @return awaitable that results in the connected socket.
+         * @exception std::system_error thrown if the socket could not be created.
+         * @exception ssl::error thrown (when awaited) if the connection is closed during the handshake.
+         */
+        auto connect(const ssl::tcp::client_context& context, const socket_address& server_addr, const std::string& server_name = std::string()) {
+            auto s = std::make_shared<ssl::tcp::client_socket>(context, std::nullopt, server_addr, server_name, false, true);
+            return make_operation<std::shared_ptr<ssl::tcp::client_socket>>(s, [this, s](operation& op, std::shared_ptr<ssl::tcp::client_socket>& result) {
+                if (!continue_handshake(op, s)) {
+                    return false;
+                }
+                result = s;
+                return true;
+                });
+        }
+
+    private:
+        //registration of a socket
+        struct socket_state {
+            socket_ptr socket;
+            operation* waiters[2]{};
+            bool registered[2]{};
+        };
+
+        //the socket poller
+        socket_poller& m_poller;
+
+        //mutex for synchronization
+        std::mutex m_mutex;
+
+        //registered sockets
+        std::unordered_map<socket*, socket_state> m_sockets;
+
+        //registers the operation to wait for its socket
+        void wait(operation& op);
+
+        //invoked when the socket poller reports a socket as ready
+        void on_socket_ready(const socket_ptr& s, event_type e);
+
+        //removes a socket from the socket poller; the mutex must be locked
+        void unregister(socket_state& st);
+
+        //converts the status of a non-blocking operation to the result of a step
+        static bool complete(operation& op, io_status status, bool& result);
+
+        //accepts a connection; the client socket is non-blocking
+        static std::shared_ptr<unencrypted::tcp::client_socket> accept_connection(unencrypted::tcp::server_socket& s, socket_address& addr);
+
+        //creates a socket that is connecting in non-blocking mode
+        static std::shared_ptr<unencrypted::tcp::client_socket> create_connecting_socket(const socket_address& server_addr);
+
+        //continues a connection; returns true when connected
+        bool continue_connect(operation& op, const std::shared_ptr<unencrypted::tcp::client_socket>& s);
+
+        //continues a handshake; returns true when complete
+        bool continue_handshake(operation& op, const std::shared_ptr<ssl::tcp::client_socket>& s);
+    };
+
+
+} //namespace netlib
+
+
+#endif //defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+
+#endif //NETLIB_ASYNC_CONTEXT_HPP
@@ -0,0 +1,219 @@
+#ifndef NETLIB_CALLBACK_HPP
+#define NETLIB_CALLBACK_HPP
+
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <functional>
+
+
+/**
+ * Callback buffer size preprocessor definition.
+ * Number of bytes a callback can store without allocating memory;
+ * larger function objects are allocated on the heap.
+ */
+#ifndef NETLIB_CALLBACK_BUFFER_SIZE
+#define NETLIB_CALLBACK_BUFFER_SIZE 48
+#endif
+
+
+static_assert(NETLIB_CALLBACK_BUFFER_SIZE >= sizeof(void*), "NETLIB_CALLBACK_BUFFER_SIZE must be able to hold a pointer.");
+
+
+namespace netlib {
+
+
+    template <class Signature> class callback;
+
+
+    /**
+     * A move-only function wrapper.
+     * Function objects that fit in the internal buffer, and that can be moved without throwing,
+     * are stored in the buffer, without allocating memory.
+     * Since it is not copyable, it can hold function objects that are not copyable.
+     * @param R return type.
+     * @param Args argument types.
+     */
+    template <class R, class... Args> class callback<R(Args...)> {
+    public:
+        /**
+         * The default constructor.
+         * An empty callback is created.
+         */
+        callback() noexcept : m_operations(nullptr) {
+        }
+
+        /**
+         * Constructor from null.
+         * An empty callback is created.
+         */
+        callback(std::nullptr_t) noexcept : m_operations(nullptr) {
+        }
+
+        /**
+         * Constructor from function object.
+         * @param f function object; if it is an empty std::function or a null function pointer, the callback is empty.
+         */
+        template <class F, class = std::enable_if_t<!std::is_same_v<std::decay_t<F>, callback> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>>>
+        callback(F&& f) : m_operations(nullptr) {
+            using T = std::decay_t<F>;
+            if constexpr (std::is_pointer_v<T> || std::is_member_pointer_v<T> || is_std_function<T>::value) {
+                if (!f) {
+                    return;
+                }
+            }
+            if constexpr (is_stored_in_buffer<T>()) {
+                new (m_buffer) T(std::forward<F>(f));
+            }
+            else {
+                *reinterpret_cast<T**>(m_buffer) = new T(std::forward<F>(f));
+            }
+            m_operations = &operations_of<T>;
+        }
+
+        /**
+         * The object is not copyable.
+         */
+        callback(const callback&) = delete;
+
+        /**
+         * The move constructor.
+         * @param src source object; it becomes empty.
+         */
+        callback(callback&& src) noexcept : m_operations(src.m_operations) {
+            if (m_operations) {
+                m_operations->move(src.m_buffer, m_buffer);
+                src.m_operations = nullptr;
+            }
+        }
+
+        /**
+         * Destroys the function object.
+         */
+        ~callback() {
+            reset();
+        }
+
+        /**
+         * The object is not copyable.
+         */
+        callback& operator = (const callback&) = delete;
+
+        /**
+         * The move assignment operator.
+         * @param src source object; it becomes empty.
+         * @return reference to this.
+         */
+        callback& operator = (callback&& src) noexcept {
+            if (this != &src) {
+                reset();
+                if (src.m_operations) {
+                    src.m_operations->move(src.m_buffer, m_buffer);
+                    m_operations = src.m_operations;
+                    src.m_operations = nullptr;
+                }
+            }
+            return *this;
+        }
+
+        /**
+         * Empties the callback.
+         * @return reference to this.
+         */
+        callback& operator = (std::nullptr_t) noexcept {
+            reset();
+            return *this;
+        }
+
+        /**
+         * Returns true if the callback is not empty.
+         */
+        explicit operator bool() const noexcept {
+            return m_operations != nullptr;
+        }
+
+        /**
+         * Invokes the function object.
+         * @param args arguments.
+         * @return the result of the function object.
+         * @exception std::bad_function_call thrown if the callback is empty.
+         */
+        R operator ()(Args... args) const {
+            if (!m_operations) {
+                throw std::bad_function_call();
+            }
+            return m_operations->invoke(const_cast<unsigned char*>(m_buffer), std::forward<Args>(args)...);
+        }
+
+    private:
+        //operations on the stored function object
+        struct operations {
+            R(*invoke)(void* buffer, Args&&... args);
+            void(*move)(void* src, void* dst) noexcept;
+            void(*destroy)(void* buffer) noexcept;
+        };
+
+        template <class T> struct is_std_function : std::false_type {
+        };
+
+        template <class S> struct is_std_function<std::function<S>> : std::true_type {
+        };
+
+        //checks if a function object of the given type is stored in the buffer
+        template <class T> static constexpr bool is_stored_in_buffer() {
+            return sizeof(T) <= NETLIB_CALLBACK_BUFFER_SIZE && alignof(std::max_align_t) % alignof(T) == 0 && std::is_nothrow_move_constructible_v<T>;
+        }
+
+        //returns the stored function object
+        template <class T> static T& get(void* buffer) {
+            if constexpr (is_stored_in_buffer<T>()) {
+                return *std::launder(reinterpret_cast<T*>(buffer));
+            }
+            else {
+                return **reinterpret_cast<T**>(buffer);
+            }
+        }
+
+        //operations of function objects of the given type
+        template <class T> static constexpr operations operations_of{
+            [](void* buffer, Args&&... args) -> R {
+                return static_cast<R>(std::invoke(get<T>(buffer), std::forward<Args>(args)...));
+            },
+            [](void* src, void* dst) noexcept {
+                if constexpr (is_stored_in_buffer<T>()) {
+                    new (dst) T(std::move(get<T>(src)));
+                    get<T>(src).~T();
+                }
+                else {
+                    *reinterpret_cast<T**>(dst) = *reinterpret_cast<T**>(src);
+                }
+            },
+            [](void* buffer) noexcept {
+                if constexpr (is_stored_in_buffer<T>()) {
+                    get<T>(buffer).~T();
+                }
+                else {
+                    delete *reinterpret_cast<T**>(buffer);
+                }
+            }
+        };
+
+        alignas(std::max_align_t) unsigned char m_buffer[NETLIB_CALLBACK_BUFFER_SIZE];
+        const operations* m_operations;
+
+        //destroys the function object
+        void reset() noexcept {
+            if (m_operations) {
+                m_operations->destroy(m_buffer);
+                m_operations = nullptr;
+            }
+        }
+    };
+
+
+} //namespace netlib
+
+
+#endif //NETLIB_CALLBACK_HPP
@@ -0,0 +1,182 @@
+#ifndef NETLIB_CONNECTION_POOL_HPP
+#define NETLIB_CONNECTION_POOL_HPP
+
+
+#include <memory>
+#include <string>
+#include <chrono>
+#include <cstddef>
+#include "socket.hpp"
+#include "socket_address.hpp"
+#include "socket_options.hpp"
+
+
+namespace netlib {
+
+
+    /**
+     * Connection pool options.
+     * The limits apply per pool key (server address, and for ssl, context and server name).
+     */
+    struct connection_pool_options {
+        /**
+         * max number of idle connections kept; returned connections beyond it are closed.
+         */
+        size_t max_idle = 8;
+
+        /**
+         * max number of connections, idle or in use; acquiring more waits until a connection is returned.
+         */
+        size_t max_total = 64;
+
+        /**
+         * time after which idle connections are closed.
+         */
+        std::chrono::milliseconds idle_timeout{ 60000 };
+
+        /**
+         * max time to wait for a connection, either for a new connection to be established,
+         * or for a connection to be returned, when max_total is reached.
+         */
+        std::chrono::milliseconds connect_timeout{ 5000 };
+
+        /**
+         * options set on new connections.
+         */
+        socket_options connection_options;
+    };
+
+
+    /**
+     * Base class for connection pools.
+     * Connections are handed out as shared pointers; when the last pointer to a connection is released,
+     * the connection returns to the pool, to be reused by the next request to the same key,
+     * without the cost of connecting (and of the ssl handshake).
+     * On checkout, idle connections are checked: connections that are closed by the other side,
+     * or that have unread data, are closed instead of being reused.
+     * Idle connections are closed after the idle timeout; they are evicted when connections
+     * are acquired, and when evict_idle() is called.
+     * A connection that is found broken while in use shall be passed to discard(), so as that it is not reused.
+     * Connections may outlive the pool; then they are closed when released.
+     * Thread-safe class.
+     */
+    class connection_pool {
+    public:
+        /**
+         * The object is not copyable.
+         */
+        connection_pool(const connection_pool&) = delete;
+
+        /**
+         * The object is not copyable.
+         */
+        connection_pool& operator = (const connection_pool&) = delete;
+
+        /**
+         * Closes the idle connections.
+         */
+        virtual ~connection_pool();
+
+        /**
+         * Returns the options of the pool.
+         */
+        const connection_pool_options& options() const;
+
+        /**
+         * Returns the number of idle connections.
+         */
+        size_t idle_count() const;
+
+        /**
+         * Returns the number of connections, idle or in use.
+         */
+        size_t connection_count() const;
+
+        /**
+         * Closes the idle connections that exceeded the idle timeout.
+         * It can be called periodically, so as that idle connections are closed without waiting for the next checkout.
+         */
+        void evict_idle();
+
+        /**
+         * Marks a connection as not reusable; it is closed when released.
+         * @param s connection acquired from this pool.
+         */
+        void discard(const std::shared_ptr<socket>& s);
+
+    protected:
+        //key of connections
+        struct key {
+            socket_address address;
+            std::shared_ptr<void> context;
+            std::string server_name;
+
+            bool operator == (const key& other) const {
+                return address == other.address && context == other.context && server_name == other.server_name;
+            }
+        };
+
+        //state of the pool; defined in the implementation
+        class state;
+
+        /**
+         * Constructor.
+         * @param options options.
+         * @exception std::invalid_argument thrown if max_total is 0.
+         */
+        connection_pool(const connection_pool_options& options);
+
+        /**
+         * Takes a healthy idle connection, or reserves a slot for a new connection.
+         * @param k key.
+         * @param deadline time to wait until a slot is available.
+         * @return an idle connection, or null if a slot is reserved for a new connection.
+         * @exception std::system_error thrown with the connection timeout error, if no slot was available until the deadline.
+         */
+        std::unique_ptr<socket> checkout(const key& k, std::chrono::steady_clock::time_point deadline);
+
+        /**
+         * Releases a slot reserved by checkout(), if the new connection failed.
+         * @param k key.
+         */
+        void cancel(const key& k);
+
+        /**
+         * Checks if an idle connection can be reused:
+         * it must not have buffered data, and it must not be readable, since the other side
+         * has not sent a request; a readable socket either is closed, or has unexpected data.
+         * @param s connection.
+         * @return true if the connection can be reused.
+         */
+        virtual bool is_healthy(socket& s) const;
+
+        /**
+         * Returns the time remaining until the deadline, at least 0.
+         * @param deadline deadline.
+         */
+        static std::chrono::milliseconds get_remaining_time(std::chrono::steady_clock::time_point deadline);
+
+        /**
+         * Hands out a connection; it returns to the pool when the last pointer to it is released.
+         * @param k key.
+         * @param s connection.
+         * @return shared pointer to the connection.
+         */
+        template <class S> std::shared_ptr<S> hand_out(const key& k, std::unique_ptr<S>&& s) {
+            return std::shared_ptr<S>(s.release(), [pool_state = std::weak_ptr<state>(m_state), k](S* p) {
+                release(pool_state, k, std::unique_ptr<socket>(p));
+                });
+        }
+
+    private:
+        std::shared_ptr<state> m_state;
+
+        //returns a connection to the pool, or closes it if the pool is gone
+        static void release(const std::weak_ptr<state>& st, const key& k, std::unique_ptr<socket>&& s);
+    };
+
+
+} //namespace netlib
+
+
+#endif //NETLIB_CONNECTION_POOL_HPP
@@ -0,0 +1,320 @@
+#ifndef NETLIB_IO_ENGINE_HPP
+#define NETLIB_IO_ENGINE_HPP
+
+
+#include <functional>
+#include <vector>
+#include <deque>
+#include <array>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include "socket_poller.hpp"
+#include "unencrypted_tcp_client_socket.hpp"
+#include "unencrypted_tcp_server_socket.hpp"
+#include "unencrypted_udp_socket.hpp"
+
+
+/**
+ * I/O engine queue size preprocessor definition.
+ * Number of submission queue entries of the io_uring instance.
+ */
+#ifndef NETLIB_IO_ENGINE_QUEUE_SIZE
+#define NETLIB_IO_ENGINE_QUEUE_SIZE 256
+#endif
+
+
+/**
+ * I/O engine io_uring backend preprocessor definition.
+ * If true, the I/O engine uses io_uring, if it is available at runtime;
+ * otherwise, it uses a socket poller.
+ * By default, it is true on Linux, false everywhere else.
+ */
+#ifndef NETLIB_IO_ENGINE_IO_URING
+#ifdef __linux__
+#define NETLIB_IO_ENGINE_IO_URING true
+#else
+#define NETLIB_IO_ENGINE_IO_URING false
+#endif
+#endif
+
+
+namespace netlib {
+
+
+    /**
+     * A completion-based I/O engine.
+     * Operations are queued, then submitted in batches from poll(),
+     * which also invokes the completion callbacks.
+     * It uses io_uring, where available; otherwise, it performs the operations without blocking
+     * when a socket poller reports the sockets as ready.
+     * The buffers passed to the operations must stay valid until the operations complete.
+     * Operations can be queued from any thread; poll() must be called from one thread at a time.
+     */
+    class io_engine {
+    public:
+        using socket_ptr = std::shared_ptr<socket>;
+        using poll_status = socket_poller::poll_status;
+
+        /**
+         * operation type.
+         */
+        enum class operation_type {
+            /**
+             * send over a tcp client socket.
+             */
+            send,
+
+            /**
+             * receive over a tcp client socket.
+             */
+            receive,
+
+            /**
+             * send over a udp socket.
+             */
+            send_to,
+
+            /**
+             * receive over a udp socket.
+             */
+            receive_from,
+
+            /**
+             * accept a connection over a tcp server socket.
+             */
+            accept,
+
+            /**
+             * connect a new tcp client socket.
+             */
+            connect
+        };
+
+        /**
+         * Operation completion.
+         */
+        struct completion {
+            /**
+             * operation type.
+             */
+            operation_type type;
+
+            /**
+             * socket of the operation; for connect operations, the socket that was created for the connection.
+             */
+            socket_ptr socket;
+
+            /**
+             * number of bytes transferred; for receive operations, 0 means the connection was closed.
+             */
+            size_t bytes;
+
+            /**
+             * error number; 0 on success.
+             */
+            int error_number;
+
+            /**
+             * address of the sender for receive_from operations, of the client for accept operations.
+             */
+            socket_address address;
+
+            /**
+             * for accept and connect operations, the connected socket; null on error.
+             */
+            std::shared_ptr<unencrypted::tcp::client_socket> client_socket;
+        };
+
+        /**
+         * completion callback type.
+         */
+        using completion_callback_type = std::function<void(io_engine&, const completion&)>;
+
+        /**
+         * queue size.
+         */
+        static constexpr size_t queue_size = NETLIB_IO_ENGINE_QUEUE_SIZE;
+
+        /**
+         * Constructor.
+         * @param queue_size number of io_uring submission queue entries.
+         * @exception std::system_error thrown if the engine could not be created.
+         */
+        io_engine(size_t queue_size = io_engine::queue_size);
+
+        /**
+         * The object is not copyable.
+         */
+        io_engine(const io_engine&) = delete;
+
+        /**
+         * The object is not movable.
+         */
+        io_engine(io_engine&&) = delete;
+
+        /**
+         * Stops the engine.
+         */
+        ~io_engine();
+
+        /**
+         * The object is not copyable.
+         */
+        io_engine& operator = (const io_engine&) = delete;
+
+        /**
+         * The object is not movable.
+         */
+        io_engine& operator = (io_engine&&) = delete;
+
+        /**
+         * Checks if io_uring is used.
+         * @return true if io_uring is used, false if the socket poller is used.
+         */
+        bool uses_io_uring() const {
+            return m_ring != nullptr;
+        }
+
+        /**
+         * Queues a send operation.
+         * The operation completes when some of the data are sent.
+         * @param s socket.
+         * @param data data to send.
+         * @param size number of bytes to send.
+         * @param cb completion callback.
+         * @exception std::invalid_argument thrown if any of the parameters is invalid.
+         */
+        void send(const std::shared_ptr<unencrypted::tcp::client_socket>& s, const char* data, size_t size, const completion_callback_type& cb);
+
+        /**
+         * Queues a receive operation.
+         * The operation completes when some data are received.
+         * @param s socket.
+         * @param buffer reception buffer.
+         * @param size size of the reception buffer.
+         * @param cb completion callback.
+         * @exception std::invalid_argument thrown if any of the parameters is invalid.
+         */
+        void receive(const std::shared_ptr<unencrypted::tcp::client_socket>& s, char* buffer, size_t size, const completion_callback_type& cb);
+
+        /**
+         * Queues a datagram send operation.
+         * @param s socket.
+         * @param data data to send.
+         * @param size number of bytes to send.
+         * @param receiver_addr receiver address.
+         * @param cb completion callback.
+         * @exception std::invalid_argument thrown if any of the parameters is invalid.
+         */
+        void send_to(const std::shared_ptr<unencrypted::udp::socket>& s, const char* data, size_t size, const socket_address& receiver_addr, const completion_callback_type& cb);
+
+        /**
+         * Queues a datagram receive operation.
+         * @param s socket.
+         * @param buffer reception buffer.
+         * @param size size of the reception buffer.
+         * @param cb completion callback.
+         * @exception std::invalid_argument thrown if any of the parameters is invalid.
+         */
+        void receive_from(const std::shared_ptr<unencrypted::udp::socket>& s, char* buffer, size_t size, const completion_callback_type& cb);
+
+        /**
+         * Queues an accept operation.
+         * @param s server socket.
+         * @param cb completion callback.
+         * @exception std::invalid_argument thrown if any of the parameters is invalid.
+         */
+        void accept(const std::shared_ptr<unencrypted::tcp::server_socket>& s, const completion_callback_type& cb);
+
+        /**
+         * Queues a connect operation.
+         * A new tcp client socket is created for the connection.
+         * @param server_addr address of server.
+         * @param cb completion callback.
+         * @exception std::invalid_argument thrown if the callback is empty.
+         * @exception std::system_error thrown if the socket could not be created.
+         */
+        void connect(const socket_address& server_addr, const completion_callback_type& cb);
+
+        /**
+         * Submits the queued operations, waits for completions,
+         * then invokes the completion callbacks.
+         * @param timeout_ms timeout, in milliseconds. If less than 0, then it blocks until there is a completion.
+         * @return poll status.
+         * @exception std::system_error thrown if there was an error.
+         */
+        poll_status poll(int timeout_ms = -1);
+
+        /**
+         * Stops the engine, if not stopped yet.
+         * Also invoked in the destructor.
+         */
+        void stop();
+
+    private:
+        //operation; defined in the implementation
+        struct operation;
+
+        //io_uring instance; defined in the implementation
+        struct ring;
+
+        //mutex for synchronization
+        std::mutex m_mutex;
+
+        //if stopped
+        bool m_stop;
+
+        //io_uring instance; null if io_uring is not available
+        std::unique_ptr<ring> m_ring;
+
+        #if NETLIB_IO_ENGINE_IO_URING
+        //operations queued, but not yet submitted to io_uring
+        std::vector<std::unique_ptr<operation>> m_pending_operations;
+
+        //operations submitted to io_uring, by id
+        std::unordered_map<uint64_t, std::unique_ptr<operation>> m_operations;
+
+        //id of the next io_uring operation
+        uint64_t m_next_operation_id;
+
+        //if the polling thread waits for io_uring completions
+        bool m_waiting;
+
+        //if the polling thread is signaled to wake up, but the signal is not yet received
+        std::atomic<bool> m_wakeup_pending;
+        #endif
+
+        //socket poller, used if io_uring is not available
+        socket_poller m_poller;
+
+        //operations waiting for the socket poller, by socket handle and event type
+        std::unordered_map<socket::handle_type, std::array<std::deque<std::unique_ptr<operation>>, 2>> m_poller_operations;
+
+        //queues an operation
+        void queue(std::unique_ptr<operation>&& op);
+
+        #if NETLIB_IO_ENGINE_IO_URING
+        //submits an operation to io_uring
+        void submit(std::unique_ptr<operation>&& op);
+
+        //submits the read of the wakeup handle to io_uring
+        void submit_wakeup();
+
+        //processes the io_uring completions; returns the number of callbacks invoked
+        size_t process_completions();
+
+        //io_uring poll
+        poll_status ring_poll(int timeout_ms);
+        #endif
+
+        //invoked when the socket poller reports a socket as ready
+        void on_socket_ready(const socket_ptr& s, socket_poller::event_type e);
+    };
+
+
+} //namespace netlib
+
+
+#endif //NETLIB_IO_ENGINE_HPP
@@ -0,0 +1,39 @@
+#ifndef NETLIB_IO_STATUS_HPP
+#define NETLIB_IO_STATUS_HPP
+
+
+namespace netlib {
+
+
+    /**
+     * Status of non-blocking operations.
+     * When an operation cannot complete without blocking, the status tells which event
+     * the socket shall be polled for, before the operation is invoked again.
+     */
+    enum class io_status {
+        /**
+         * the operation is complete.
+         */
+        done,
+
+        /**
+         * the operation shall be invoked again when the socket is ready for reading.
+         */
+        want_read,
+
+        /**
+         * the operation shall be invoked again when the socket is ready for writing.
+         */
+        want_write,
+
+        /**
+         * the connection is closed.
+         */
+        closed
+    };
+
+
+} //namespace netlib
+
+
+#endif //NETLIB_IO_STATUS_HPP
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <array>
 #include <string>
+#include <vector>
 #include <functional>
 
 
@@ -108,6 +109,29 @@ namespace netlib {
         {
         }
 
+        /**
+         * Resolves a hostname/ip address string to all of its ip addresses.
+         * @param hostname hostname/ip address string;
+         *  if null/empty, then the ip addresses of the localhost are discovered.
+         * @param type address family; if 0, then the addresses of both families are returned.
+         * @return the addresses, without duplicates, in the order of preference of the resolver.
+         * @exception std::invalid_argument if the address family is not supported.
+         * @exception std::system_error if a system error happens.
+         * @exception std::logic_error if the hostname is valid but cannot be resolved to an IP4/IP6 address.
+         */
+        static std::vector<ip_address> resolve(const char* hostname, int type = 0);
+
+        /**
+         * Resolves a hostname/ip address string to all of its ip addresses.
+         * @param hostname hostname/ip address string;
+         *  if empty, then the ip addresses of the localhost are discovered.
+         * @param type address family; if 0, then the addresses of both families are returned.
+         * @return the addresses, without duplicates, in the order of preference of the resolver.
+         */
+        static std::vector<ip_address> resolve(const std::string& hostname, int type = 0) {
+            return resolve(hostname.c_str(), type);
+        }
+
         /**
          * Returns the address family.
          */
@@ -245,8 +269,8 @@ namespace netlib {
 
     private:
         int m_address_family;
-        std::array<char, 16> m_data;
-        uint32_t m_zone_index;
+        std::array<char, 16> m_data{};
+        uint32_t m_zone_index{ 0 };
     };
 
 
@@ -0,0 +1,232 @@
+#ifndef NETLIB_MESSAGE_BUFFER_HPP
+#define NETLIB_MESSAGE_BUFFER_HPP
+
+
+#include <cstddef>
+#include <atomic>
+#include <utility>
+#include <stdexcept>
+
+
+/**
+ * Message buffer min capacity preprocessor definition.
+ * Capacity of the smallest size class; it must be a power of 2.
+ */
+#ifndef NETLIB_MESSAGE_BUFFER_MIN_CAPACITY
+#define NETLIB_MESSAGE_BUFFER_MIN_CAPACITY 64
+#endif
+
+
+/**
+ * Message buffer max capacity preprocessor definition.
+ * Capacity of the largest size class; it must be a power of 2.
+ * Larger buffers are allocated and freed individually.
+ */
+#ifndef NETLIB_MESSAGE_BUFFER_MAX_CAPACITY
+#define NETLIB_MESSAGE_BUFFER_MAX_CAPACITY 65536
+#endif
+
+
+/**
+ * Message buffer slab size preprocessor definition.
+ * Number of bytes allocated at once for the buffers of a size class.
+ */
+#ifndef NETLIB_MESSAGE_BUFFER_SLAB_SIZE
+#define NETLIB_MESSAGE_BUFFER_SLAB_SIZE 262144
+#endif
+
+
+/**
+ * Message buffer thread cache size preprocessor definition.
+ * Max number of released buffers of each size class that a thread keeps for reuse;
+ * beyond that, released buffers are moved to a cache shared by all threads.
+ */
+#ifndef NETLIB_MESSAGE_BUFFER_THREAD_CACHE_SIZE
+#define NETLIB_MESSAGE_BUFFER_THREAD_CACHE_SIZE 64
+#endif
+
+
+namespace netlib {
+
+
+    /**
+     * A reference-counted buffer for message payloads.
+     * The memory of buffers comes from slabs of size classes (powers of 2);
+     * released buffers are kept by the releasing thread for reuse, without locking,
+     * so as that receiving and sending messages in steady state does not allocate memory.
+     * The memory of slabs is reused, but not returned to the system.
+     * Copies share the same memory and size; the memory is released when the last copy is destroyed.
+     * The reference count is thread-safe; the data are not synchronized.
+     */
+    class message_buffer {
+    public:
+        /**
+         * The default constructor.
+         * An empty buffer is created.
+         */
+        message_buffer() noexcept : m_block(nullptr) {
+        }
+
+        /**
+         * Acquires a buffer with at least the given capacity, and size 0.
+         * The memory of the buffer is not initialized.
+         * @param capacity min capacity.
+         */
+        explicit message_buffer(size_t capacity);
+
+        /**
+         * The copy constructor.
+         * The memory is shared.
+         * @param src source object.
+         */
+        message_buffer(const message_buffer& src) noexcept : m_block(src.m_block) {
+            if (m_block) {
+                m_block->ref_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * The move constructor.
+         * @param src source object; it becomes empty.
+         */
+        message_buffer(message_buffer&& src) noexcept : m_block(std::exchange(src.m_block, nullptr)) {
+        }
+
+        /**
+         * Releases the memory, if this is the last copy.
+         */
+        ~message_buffer() {
+            reset();
+        }
+
+        /**
+         * The copy assignment operator.
+         * The memory is shared.
+         * @param src source object.
+         * @return reference to this.
+         */
+        message_buffer& operator = (const message_buffer& src) noexcept {
+            if (m_block != src.m_block) {
+                if (src.m_block) {
+                    src.m_block->ref_count.fetch_add(1, std::memory_order_relaxed);
+                }
+                reset();
+                m_block = src.m_block;
+            }
+            return *this;
+        }
+
+        /**
+         * The move assignment operator.
+         * @param src source object; it becomes empty.
+         * @return reference to this.
+         */
+        message_buffer& operator = (message_buffer&& src) noexcept {
+            if (this != &src) {
+                reset();
+                m_block = std::exchange(src.m_block, nullptr);
+            }
+            return *this;
+        }
+
+        /**
+         * Returns true if the buffer is not empty.
+         */
+        explicit operator bool() const {
+            return m_block != nullptr;
+        }
+
+        /**
+         * Returns the data.
+         */
+        char* data() {
+            return m_block ? reinterpret_cast<char*>(m_block + 1) : nullptr;
+        }
+
+        /**
+         * Returns the data.
+         */
+        const char* data() const {
+            return m_block ? reinterpret_cast<const char*>(m_block + 1) : nullptr;
+        }
+
+        /**
+         * Returns the number of bytes used.
+         */
+        size_t size() const {
+            return m_block ? m_block->size : 0;
+        }
+
+        /**
+         * Returns the capacity of the buffer.
+         */
+        size_t capacity() const {
+            return m_block ? m_block->capacity : 0;
+        }
+
+        /**
+         * Returns the number of copies that share the memory of the buffer.
+         */
+        size_t use_count() const {
+            return m_block ? m_block->ref_count.load(std::memory_order_relaxed) : 0;
+        }
+
+        /**
+         * Sets the number of bytes used; the memory is not initialized.
+         * The size is shared by all copies.
+         * @param size number of bytes used.
+         * @exception std::length_error thrown if the size exceeds the capacity.
+         */
+        void resize(size_t size) {
+            if (size > capacity()) {
+                throw std::length_error("Buffer size exceeds the buffer capacity.");
+            }
+            if (m_block) {
+                m_block->size = size;
+            }
+        }
+
+        /**
+         * Makes the buffer an unshared buffer with at least the given capacity, and size 0;
+         * the current memory is reused if it is not shared and it has enough capacity.
+         * @param capacity min capacity.
+         */
+        void reserve(size_t capacity) {
+            if (use_count() != 1 || m_block->capacity < capacity) {
+                *this = message_buffer(capacity);
+            }
+            m_block->size = 0;
+        }
+
+        /**
+         * Releases the memory, if this is the last copy; the buffer becomes empty.
+         */
+        void reset() {
+            if (m_block) {
+                if (m_block->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    release(m_block);
+                }
+                m_block = nullptr;
+            }
+        }
+
+    private:
+        //header of the memory of a buffer; the data follow it
+        struct alignas(std::max_align_t) block {
+            std::atomic<size_t> ref_count;
+            size_t size;
+            size_t capacity;
+            size_t size_class;
+        };
+
+        block* m_block;
+
+        //releases the memory of a buffer
+        static void release(block* b);
+    };
+
+
+} //namespace netlib
+
+
+#endif //NETLIB_MESSAGE_BUFFER_HPP
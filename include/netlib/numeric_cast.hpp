@@ -27,7 +27,7 @@ namespace netlib {
          * Returns the message.
          * @return the message.
          */
-        const char* what() const override {
+        const char* what() const noexcept override {
             return m_message.c_str();
         }
 
@@ -0,0 +1,181 @@
+#ifndef NETLIB_RECEIVE_BUFFER_HPP
+#define NETLIB_RECEIVE_BUFFER_HPP
+
+
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+
+/**
+ * Receive buffer size preprocessor definition.
+ * Default size of the receive buffer of stream sockets; if 0, received data are not buffered.
+ */
+#ifndef NETLIB_RECEIVE_BUFFER_SIZE
+#define NETLIB_RECEIVE_BUFFER_SIZE 16384
+#endif
+
+
+namespace netlib {
+
+
+    /**
+     * Receive buffer for stream sockets.
+     * It reads as much data as the source has available, up to its capacity,
+     * then serves subsequent reads from the buffered data,
+     * so as that multiple small messages are received with one system call.
+     * The memory of the buffer is allocated on the first read.
+     */
+    class receive_buffer {
+    public:
+        /**
+         * Constructor.
+         * @param capacity capacity of the buffer; if 0, data are not buffered.
+         */
+        receive_buffer(size_t capacity = NETLIB_RECEIVE_BUFFER_SIZE) : m_capacity(capacity), m_begin(0), m_end(0) {
+        }
+
+        /**
+         * Returns the capacity of the buffer.
+         */
+        size_t capacity() const {
+            return m_capacity;
+        }
+
+        /**
+         * Sets the capacity of the buffer.
+         * Already buffered data are kept; the new capacity is used when the buffer is refilled.
+         * @param capacity capacity of the buffer; if 0, data are not buffered.
+         */
+        void set_capacity(size_t capacity) {
+            m_capacity = capacity;
+        }
+
+        /**
+         * Returns the number of buffered bytes.
+         */
+        size_t size() const {
+            return m_end - m_begin;
+        }
+
+        /**
+         * Returns a pointer to the buffered bytes.
+         */
+        const char* data() const {
+            return m_data.data() + m_begin;
+        }
+
+        /**
+         * Removes the given number of bytes from the start of the buffered bytes.
+         * @param size number of bytes to remove; it must not be greater than size().
+         */
+        void consume(size_t size) {
+            m_begin += size;
+            if (m_begin == m_end) {
+                m_begin = m_end = 0;
+            }
+        }
+
+        /**
+         * Reads the available data of the source, after the buffered bytes, with one call to the read function.
+         * Used for non-blocking reception, where a message is taken from the buffer only after all of its bytes are buffered.
+         * @param size number of bytes the buffer shall be able to hold; the buffer grows beyond its capacity, if needed.
+         * @param read_function function that reads available data from the source; same as in read().
+         * @return the value returned by the read function.
+         */
+        template <class F> int fill(size_t size, F&& read_function) {
+            //move the buffered data to the start of the buffer
+            if (m_begin > 0) {
+                std::memmove(m_data.data(), m_data.data() + m_begin, m_end - m_begin);
+                m_end -= m_begin;
+                m_begin = 0;
+            }
+
+            //make room for the new data
+            const size_t new_size = std::max({ size, m_capacity, m_end + 1 });
+            if (m_data.size() < new_size) {
+                m_data.resize(new_size);
+            }
+
+            const int s = read_function(m_data.data() + m_end, m_data.size() - m_end);
+            if (s > 0) {
+                m_end += static_cast<size_t>(s);
+            }
+            return s;
+        }
+
+        /**
+         * Reads the given number of bytes.
+         * Requests at least as large as the capacity of the buffer are read directly into the destination.
+         * @param data destination.
+         * @param size number of bytes to read.
+         * @param read_function function with signature int(char* data, size_t size) that reads available data from the source;
+         *  it returns the number of bytes read, or 0 if the source is closed; it throws on error.
+         * @return true on success, false if the source is closed.
+         */
+        template <class F> bool read(char* data, size_t size, F&& read_function) {
+            while (size > 0) {
+                //serve the buffered data
+                if (m_begin < m_end) {
+                    const size_t count = std::min(size, m_end - m_begin);
+                    std::memcpy(data, m_data.data() + m_begin, count);
+                    m_begin += count;
+                    data += count;
+                    size -= count;
+                    continue;
+                }
+
+                //large request; read directly into the destination
+                if (size >= m_capacity) {
+                    const int s = read_function(data, size);
+                    if (s <= 0) {
+                        return false;
+                    }
+                    data += s;
+                    size -= static_cast<size_t>(s);
+                    continue;
+                }
+
+                //refill the buffer
+                m_data.resize(m_capacity);
+                const int s = read_function(m_data.data(), m_capacity);
+                if (s <= 0) {
+                    return false;
+                }
+                m_begin = 0;
+                m_end = static_cast<size_t>(s);
+            }
+
+            return true;
+        }
+
+        /**
+         * Skips the given number of bytes.
+         * @param size number of bytes to skip.
+         * @param read_function function that reads available data from the source; same as in read().
+         * @return true on success, false if the source is closed.
+         */
+        template <class F> bool skip(size_t size, F&& read_function) {
+            char temp[1024];
+            while (size > 0) {
+                const size_t count = std::min(size, sizeof(temp));
+                if (!read(temp, count, read_function)) {
+                    return false;
+                }
+                size -= count;
+            }
+            return true;
+        }
+
+    private:
+        std::vector<char> m_data;
+        size_t m_capacity;
+        size_t m_begin;
+        size_t m_end;
+    };
+
+
+} //namespace netlib
+
+
+#endif //NETLIB_RECEIVE_BUFFER_HPP
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <functional>
 #include "socket_address.hpp"
+#include "socket_options.hpp"
 
 
 namespace netlib {
@@ -12,6 +13,7 @@ namespace netlib {
 
     /**
      * Base class for sockets.
+     * On POSIX systems, writing to a socket closed by the peer makes the write fail instead of raising SIGPIPE.
      */
     class socket {
     public:
@@ -67,6 +69,16 @@ namespace netlib {
          */
         virtual handle_type handle() const = 0;
 
+        /**
+         * Returns the number of received bytes that are buffered in user space.
+         * The operating system does not report a socket as readable because of these data;
+         * the socket poller invokes the read callback of level-triggered entries while there are such data.
+         * @return number of buffered received bytes; by default, 0.
+         */
+        virtual size_t buffered_receive_size() const {
+            return 0;
+        }
+
         /**
          * Returns true if the socket is valid, false otherwise.
          */
@@ -175,6 +187,23 @@ namespace netlib {
         void set_reuse_address_and_port() {
             set_reuse_address_and_port(handle());
         }
+
+        /**
+         * Sets the given options on the given socket handle.
+         * @param handle socket handle.
+         * @param options options to set; only the options that have a value are set.
+         * @exception std::system_error thrown if an option cannot be set, or if it is not available on the platform.
+         */
+        static void set_options(handle_type handle, const socket_options& options);
+
+        /**
+         * Sets the given options on the underlying socket handle.
+         * @param options options to set; only the options that have a value are set.
+         * @exception std::system_error thrown if an option cannot be set, or if it is not available on the platform.
+         */
+        void set_options(const socket_options& options) {
+            set_options(handle(), options);
+        }
     };
 
 
@@ -0,0 +1,91 @@
+#ifndef NETLIB_SOCKET_OPTIONS_HPP
+#define NETLIB_SOCKET_OPTIONS_HPP
+
+
+#include <optional>
+#include <chrono>
+
+
+namespace netlib {
+
+
+    /**
+     * Socket options.
+     * Only the options that have a value are set; the rest keep the default of the operating system.
+     * Options that are not available on the platform cause std::system_error with std::errc::no_protocol_option, if set.
+     */
+    struct socket_options {
+        /**
+         * TCP_NODELAY: if set, small segments are sent immediately, instead of being coalesced (Nagle's algorithm).
+         */
+        std::optional<bool> no_delay;
+
+        /**
+         * TCP_QUICKACK: if set, acknowledgements are sent immediately, instead of being delayed.
+         * Linux only; the kernel may turn it off later, so it might need to be set again after receiving.
+         */
+        std::optional<bool> quick_ack;
+
+        /**
+         * TCP_CORK (TCP_NOPUSH on BSD): if set, partial segments are not sent until the option is cleared,
+         * so as that data written with multiple calls are sent in full segments.
+         */
+        std::optional<bool> cork;
+
+        /**
+         * SO_SNDBUF: size of the kernel send buffer, in bytes.
+         */
+        std::optional<int> send_buffer_size;
+
+        /**
+         * SO_RCVBUF: size of the kernel receive buffer, in bytes;
+         * it shall be set before connecting or listening, since it determines the window scale of the connection.
+         */
+        std::optional<int> receive_buffer_size;
+
+        /**
+         * SO_BUSY_POLL: time to busy poll the device queue on blocking receive, when there are no data; Linux only.
+         */
+        std::optional<std::chrono::microseconds> busy_poll;
+
+        /**
+         * TCP_USER_TIMEOUT: max time transmitted data may remain unacknowledged before the connection is closed.
+         */
+        std::optional<std::chrono::milliseconds> user_timeout;
+
+        /**
+         * TCP_NOTSENT_LOWAT: max number of unsent bytes in the send buffer for the socket to be reported as writable.
+         */
+        std::optional<int> not_sent_low_water_mark;
+
+        /**
+         * SO_KEEPALIVE: if set, keepalive probes are sent on idle connections.
+         */
+        std::optional<bool> keep_alive;
+
+        /**
+         * TCP_KEEPIDLE (TCP_KEEPALIVE on macOS): idle time before the first keepalive probe.
+         */
+        std::optional<std::chrono::seconds> keep_alive_idle;
+
+        /**
+         * TCP_KEEPINTVL: interval between keepalive probes.
+         */
+        std::optional<std::chrono::seconds> keep_alive_interval;
+
+        /**
+         * TCP_KEEPCNT: number of unanswered keepalive probes before the connection is closed.
+         */
+        std::optional<int> keep_alive_count;
+
+        /**
+         * SO_PRIORITY: priority of the packets of the socket, used by the queueing disciplines; Linux only.
+         */
+        std::optional<int> priority;
+    };
+
+
+} //namespace netlib
+
+
+#endif //NETLIB_SOCKET_OPTIONS_HPP
@@ -4,10 +4,13 @@
 
 #include <functional>
 #include <vector>
+#include <array>
+#include <unordered_map>
 #include <mutex>
 #include <atomic>
 #include <memory>
 #include "socket.hpp"
+#include "callback.hpp"
 
 
 /**
@@ -18,6 +21,22 @@
 #endif
 
 
+/**
+ * Socket poller epoll backend preprocessor definition.
+ * If true, the socket poller uses epoll instead of poll.
+ * By default, it is true on Linux, false everywhere else.
+ */
+#ifndef NETLIB_SOCKET_POLLER_EPOLL
+#ifdef __linux__
+#define NETLIB_SOCKET_POLLER_EPOLL true
+#else
+#define NETLIB_SOCKET_POLLER_EPOLL false
+#endif
+#endif
+
+
+
+
 namespace netlib {
 
 
@@ -42,6 +61,30 @@ namespace netlib {
             write
         };
 
+        /**
+         * registration mode.
+         * All the entries of a socket must have the same registration mode.
+         */
+        enum class registration_mode {
+            /**
+             * the callback is invoked for as long as the socket is ready.
+             */
+            level_triggered,
+
+            /**
+             * the callback is invoked once each time the socket becomes ready;
+             * the callback must consume all the available data (e.g. via a non-blocking socket).
+             * Only supported by the epoll backend; the poll backend falls back to level triggered.
+             */
+            edge_triggered,
+
+            /**
+             * the callback is invoked once, then all the entries of the socket are disabled,
+             * until the socket is re-armed via rearm().
+             */
+            one_shot
+        };
+
         /**
          * Status flags. 
          */
@@ -65,9 +108,10 @@ namespace netlib {
         using socket_ptr = std::shared_ptr<socket>;
 
         /**
-         * event callback type. 
+         * event callback type.
+         * It is move-only; small function objects are stored without allocating memory.
          */
-        using event_callback_type = std::function<void(socket_poller&, const socket_ptr&, event_type, status_flags)>;
+        using event_callback_type = callback<void(socket_poller&, const socket_ptr&, event_type, status_flags)>;
 
         /**
          * poll status.
@@ -130,35 +174,49 @@ namespace netlib {
          * @param s socket to add.
          * @param e event type.
          * @param cb callback type.
+         * @param m registration mode.
          * @return true if the entry is added, false if the poller is full.
-         * @exception std::invalid_argument thrown if any of the parameters is invalid.
+         * @exception std::invalid_argument thrown if any of the parameters is invalid,
+         *  or if the registration mode differs from the one of the other entries of the socket.
+         * @exception std::system_error thrown if the socket cannot be registered to epoll.
          */
-        bool add(const socket_ptr& s, event_type e, const event_callback_type& cb);
+        bool add(const socket_ptr& s, event_type e, event_callback_type cb, registration_mode m = registration_mode::level_triggered);
 
         /**
          * Adds a socket for reading.
          * @param s socket to add.
          * @param cb callback.
+         * @param m registration mode.
          * @return true if the entry is added, false if the poller is full.
          * @exception std::invalid_argument thrown if any of the parameters is invalid.
          */
-        bool add(const socket_ptr& s, const event_callback_type& cb) {
-            return add(s, event_type::read, cb);
+        bool add(const socket_ptr& s, event_callback_type cb, registration_mode m = registration_mode::level_triggered) {
+            return add(s, event_type::read, std::move(cb), m);
         }
 
         /**
          * Adds a socket for reading.
          * @param s socket to add.
          * @param cb callback lambda; the socket type can be anything derived from class socket.
+         * @param m registration mode.
          * @return true if the entry is added, false if the poller is full.
          * @exception std::invalid_argument thrown if any of the parameters is invalid.
          */
-        template <class S, class F> bool add(const std::shared_ptr<S>& s, const F& cb) {
-            return add(std::static_pointer_cast<socket>(s), event_callback_type([cb](socket_poller& sp, const socket_ptr& s, event_type e, status_flags f) {
-                return cb(sp, std::static_pointer_cast<S>(s), e, f);
-                }));
+        template <class S, class F> bool add(const std::shared_ptr<S>& s, const F& cb, registration_mode m = registration_mode::level_triggered) {
+            //the typed pointer is kept with the callback, so as that it is not created on each event
+            return add(std::static_pointer_cast<socket>(s), event_callback_type([cb, typed_socket = s](socket_poller& sp, const socket_ptr&, event_type e, status_flags f) {
+                return cb(sp, typed_socket, e, f);
+                }), m);
         }
 
+        /**
+         * Re-enables the entries of a socket added in one-shot mode, after its callback was invoked.
+         * @param s socket to re-arm.
+         * @exception std::invalid_argument thrown if there is no entry for the given socket,
+         *  or if the socket was not added in one-shot mode.
+         */
+        void rearm(const socket_ptr& s);
+
         /**
          * Removes a socket entry.
          * @param s socket to add.
@@ -174,6 +232,18 @@ namespace netlib {
          */
         void remove(const socket_ptr& s);
 
+        /**
+         * Returns the number of socket entries.
+         */
+        size_t entry_count() const;
+
+        /**
+         * Checks if the given socket has entries in this poller.
+         * @param s socket to check.
+         * @return true if the socket has entries, false otherwise.
+         */
+        bool contains(const socket_ptr& s) const;
+
         /**
          * Polls all the added sockets.
          * It blocks until an event is reported.
@@ -210,11 +280,27 @@ namespace netlib {
         void stop();
 
     private:
-        //entry
+        //entry of a socket and event; allocated once, and shared by the socket entry and the dispatch data,
+        //so as that the dispatch data are updated without copying callbacks or socket pointers;
+        //it is deleted when the reference count, which is protected by the mutex, becomes 0
         struct entry {
             socket_ptr socket;
+            socket::handle_type handle;
             event_type event;
+            registration_mode mode;
             event_callback_type callback;
+            size_t ref_count;
+        };
+
+        //socket entry; one per socket handle, with one entry per event type
+        struct socket_entry {
+            socket_ptr socket;
+            registration_mode mode;
+            bool armed;
+            #if NETLIB_SOCKET_POLLER_EPOLL
+            uint32_t serial;
+            #endif
+            entry* entries[2]{};
         };
 
         //mutex for synchronization
@@ -223,14 +309,17 @@ namespace netlib {
         //max sockets
         const size_t m_max_sockets;
 
-        //internal socket used for waking up from poll.
-        socket::handle_type m_com_socket;
+        //internal handles used for waking up from poll; [0] is for reading, [1] is for writing.
+        const std::array<socket::handle_type, 2> m_com_handles;
+
+        //if a signal is sent to the com handles, but not yet received
+        std::atomic<bool> m_com_signal_pending;
 
-        //entries
-        std::vector<entry> m_entries;
+        //socket entries, by socket handle
+        std::unordered_map<socket::handle_type, socket_entry> m_entries;
 
-        //if entries are changed
-        bool m_entries_changed;
+        //number of socket/event entries
+        size_t m_entry_count;
 
         //if polling should stop
         bool m_stop;
@@ -238,17 +327,84 @@ namespace netlib {
         //sets the entries as changed
         void set_entries_changed();
 
+        //wakes up the polling thread
+        void signal_com_handle();
+
+        //invokes the callback of an entry
+        void invoke_callback(const entry& en, status_flags flags);
+
+        //removes the entry of the given socket and event; returns false if not found
+        bool remove_entry(const socket_ptr& s, event_type e);
+
+        //releases a reference to an entry; returns true if the entry is no longer referenced
+        static bool release_entry(entry* en);
+
         //callbacks
         std::function<void(const size_t entries_count, const socket_ptr& s, event_type e, const event_callback_type& cb)> m_on_socket_entry_added;
         std::function<void(const size_t entries_count, const socket_ptr& s, event_type e, const event_callback_type& cb)> m_on_socket_entry_removed;
         std::function<void(const size_t entries_count, const socket_ptr& s)> m_on_socket_removed;
 
+        //used for detecting multithreaded poll attempts
+        std::atomic<size_t> m_poll_counter;
+
+        #if NETLIB_SOCKET_POLLER_EPOLL
+        //entry which is ready to be dispatched; it holds a reference to the entry
+        struct ready_entry {
+            entry* en;
+            status_flags flags;
+        };
+
+        //epoll handle
+        int m_epoll_handle;
+
+        //serial number of the last socket entry; used for discarding events of removed sockets
+        uint32_t m_epoll_serial;
+
         //data used for polling
-        std::vector<entry> m_poll_entries;
+        std::vector<struct epoll_event> m_epoll_events;
+        std::vector<ready_entry> m_ready_entries;
+
+        //invokes epoll_ctl for the given entry
+        int epoll_update(int op, socket::handle_type handle, const socket_entry& en);
+
+        //waits for epoll events and dispatches them
+        poll_status epoll(int timeout_ms);
+
+        //releases the entries of the ready entries
+        void release_ready_entries();
+        #else
+        //poll data change type
+        enum class poll_change_type {
+            add,
+            remove,
+            rearm
+        };
+
+        //change to apply to the poll data; an added entry holds a reference to the entry
+        struct poll_change {
+            poll_change_type type;
+            socket::handle_type handle;
+            event_type event;
+            entry* en;
+            bool armed;
+        };
+
+        //changes to apply to the poll data, before the next poll
+        std::vector<poll_change> m_poll_changes;
+
+        //data used for polling; only accessed by the polling thread; each entry holds a reference to the entry
+        std::vector<entry*> m_poll_entries;
         std::vector<struct pollfd> m_poll_fds;
 
-        //used for detecting multithreaded poll attempts
-        std::atomic<size_t> m_poll_counter;
+        //indexes of the poll data, by socket handle and event type
+        std::unordered_map<socket::handle_type, std::array<size_t, 2>> m_poll_indexes;
+
+        //applies the pending changes to the poll data
+        void apply_poll_changes();
+
+        //disables the entries of the given socket, after a one-shot event
+        void disarm(const entry& en);
+        #endif
     };
 
 
@@ -0,0 +1,214 @@
+#ifndef NETLIB_SOCKET_POLLER_GROUP_HPP
+#define NETLIB_SOCKET_POLLER_GROUP_HPP
+
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include "socket_poller_thread.hpp"
+
+
+namespace netlib {
+
+
+    /**
+     * A group of socket poller threads, typically one per core.
+     * Each socket is added to one of the threads, according to a distribution policy;
+     * all the entries of a socket are added to the same thread.
+     * Thread-safe class.
+     */
+    class socket_poller_group {
+    public:
+        using socket_ptr = socket_poller::socket_ptr;
+        using event_type = socket_poller::event_type;
+        using registration_mode = socket_poller::registration_mode;
+        using event_callback_type = socket_poller::event_callback_type;
+
+        /**
+         * Built-in distribution policies.
+         */
+        enum class distribution_policy {
+            /**
+             * sockets are added to the threads in turn.
+             */
+            round_robin,
+
+            /**
+             * sockets are added to the thread with the fewest socket entries.
+             */
+            least_loaded,
+
+            /**
+             * sockets are added to the thread selected by the hash of the socket handle.
+             */
+            hash
+        };
+
+        /**
+         * Distribution function type.
+         * It returns the index of the socket poller thread to add a new socket to.
+         * It is invoked while the group is locked; it must not call add/remove on the group.
+         */
+        using distribution_function = std::function<size_t(const socket_poller_group& group, const socket_ptr& s)>;
+
+        /**
+         * Constructor.
+         * @param thread_count number of socket poller threads; if 0, the number of hardware threads is used.
+         * @param policy distribution policy.
+         * @param pin_threads if set, then each thread is bound to the core with the same index as the thread.
+         * @param max_sockets max sockets per socket poller thread.
+         * @exception std::system_error thrown if a thread cannot be pinned to a core.
+         */
+        socket_poller_group(size_t thread_count = 0, distribution_policy policy = distribution_policy::round_robin, bool pin_threads = false, size_t max_sockets = socket_poller::max_sockets);
+
+        /**
+         * Constructor.
+         * @param thread_count number of socket poller threads; if 0, the number of hardware threads is used.
+         * @param distribution distribution function.
+         * @param pin_threads if set, then each thread is bound to the core with the same index as the thread.
+         * @param max_sockets max sockets per socket poller thread.
+         * @exception std::invalid_argument thrown if the distribution function is empty.
+         * @exception std::system_error thrown if a thread cannot be pinned to a core.
+         */
+        socket_poller_group(size_t thread_count, const distribution_function& distribution, bool pin_threads = false, size_t max_sockets = socket_poller::max_sockets);
+
+        /**
+         * The object is not copyable.
+         */
+        socket_poller_group(const socket_poller_group&) = delete;
+
+        /**
+         * The object is not movable.
+         */
+        socket_poller_group(socket_poller_group&&) = delete;
+
+        /**
+         * Stops the socket poller threads and waits for their termination.
+         */
+        ~socket_poller_group();
+
+        /**
+         * The object is not copyable.
+         */
+        socket_poller_group& operator = (const socket_poller_group&) = delete;
+
+        /**
+         * The object is not movable.
+         */
+        socket_poller_group& operator = (socket_poller_group&&) = delete;
+
+        /**
+         * Returns the number of socket poller threads.
+         */
+        size_t size() const {
+            return m_pollers.size();
+        }
+
+        /**
+         * Returns a socket poller thread.
+         * @param index index of the thread.
+         * @return the socket poller thread.
+         */
+        socket_poller_thread& poller(size_t index) const {
+            return *m_pollers[index];
+        }
+
+        /**
+         * Adds a socket entry.
+         * If the socket already has entries in one of the threads, the entry is added to that thread;
+         * otherwise, the thread is selected by the distribution policy.
+         * @param s socket to add.
+         * @param e event type.
+         * @param cb callback type.
+         * @param m registration mode.
+         * @return true if the entry is added, false if the selected poller is full.
+         * @exception std::invalid_argument thrown if any of the parameters is invalid.
+         * @exception std::out_of_range thrown if the distribution function returns an invalid index.
+         */
+        bool add(const socket_ptr& s, event_type e, event_callback_type cb, registration_mode m = registration_mode::level_triggered);
+
+        /**
+         * Adds a socket for reading.
+         * @param s socket to add.
+         * @param cb callback.
+         * @param m registration mode.
+         * @return true if the entry is added, false if the selected poller is full.
+         * @exception std::invalid_argument thrown if any of the parameters is invalid.
+         */
+        bool add(const socket_ptr& s, event_callback_type cb, registration_mode m = registration_mode::level_triggered) {
+            return add(s, event_type::read, std::move(cb), m);
+        }
+
+        /**
+         * Adds a socket for reading.
+         * @param s socket to add.
+         * @param cb callback lambda; the socket type can be anything derived from class socket.
+         * @param m registration mode.
+         * @return true if the entry is added, false if the selected poller is full.
+         * @exception std::invalid_argument thrown if any of the parameters is invalid.
+         */
+        template <class S, class F> bool add(const std::shared_ptr<S>& s, const F& cb, registration_mode m = registration_mode::level_triggered) {
+            //the typed pointer is kept with the callback, so as that it is not created on each event
+            return add(std::static_pointer_cast<socket>(s), event_callback_type([cb, typed_socket = s](socket_poller& sp, const socket_ptr&, event_type e, socket_poller::status_flags f) {
+                return cb(sp, typed_socket, e, f);
+                }), m);
+        }
+
+        /**
+         * Removes a socket entry.
+         * @param s socket to add.
+         * @param e event type.
+         * @exception std::invalid_argument thrown if any of the parameters is invalid.
+         */
+        void remove(const socket_ptr& s, event_type e);
+
+        /**
+         * Removes all the entries for the given socket.
+         * @param s socket.
+         * @exception std::invalid_argument thrown if the socket is invalid.
+         * @exception std::runtime_error thrown if there is no entry for the given socket.
+         */
+        void remove(const socket_ptr& s);
+
+        /**
+         * Re-enables the entries of a socket added in one-shot mode, after its callback was invoked.
+         * @param s socket to re-arm.
+         * @exception std::invalid_argument thrown if there is no entry for the given socket,
+         *  or if the socket was not added in one-shot mode.
+         */
+        void rearm(const socket_ptr& s);
+
+        /**
+         * Signals the socket poller threads to stop,
+         * then waits for them to terminate.
+         * Also called from the destructor.
+         */
+        void stop();
+
+        /**
+         * Waits for the socket poller threads to terminate.
+         */
+        void join();
+
+    private:
+        //mutex for synchronization
+        mutable std::mutex m_mutex;
+
+        //socket poller threads
+        std::vector<std::unique_ptr<socket_poller_thread>> m_pollers;
+
+        //distribution function
+        distribution_function m_distribution;
+
+        //returns the poller that contains the given socket
+        socket_poller_thread* find_poller(const socket_ptr& s) const;
+
+        //creates the distribution function of the given policy
+        static distribution_function get_distribution_function(distribution_policy policy);
+    };
+
+
+} //namespace netlib
+
+
+#endif //NETLIB_SOCKET_POLLER_GROUP_HPP
@@ -47,6 +47,13 @@ namespace netlib {
             m_thread.detach();
         }
 
+        /**
+         * Returns the native handle of the socket poller thread.
+         */
+        std::thread::native_handle_type native_handle() {
+            return m_thread.native_handle();
+        }
+
     private:
         //the thread
         std::thread m_thread;
@@ -13,6 +13,7 @@ namespace netlib::ssl {
 
     /**
      * Base class for SSL contexts.
+     * The certificate can be replaced while the context is in use, with load_certificate().
      */
     class context {
     public:
@@ -30,6 +31,34 @@ namespace netlib::ssl {
             return m_ctx;
         }
 
+        /**
+         * Checks if kernel TLS is enabled.
+         */
+        bool kernel_tls() const;
+
+        /**
+         * Enables or disables kernel TLS for the connections created afterwards.
+         * With kernel TLS, the symmetric encryption is done by the kernel, after the handshake,
+         * if the kernel supports it for the negotiated cipher;
+         * whether it is used is reported by each socket.
+         * @param enabled if set, kernel TLS is enabled, otherwise it is disabled.
+         * @return true on success, false if kernel TLS is not supported by the ssl library.
+         */
+        bool set_kernel_tls(bool enabled);
+
+        /**
+         * Loads a new certificate and key, for the handshakes that start afterwards.
+         * The files are parsed by the calling thread, then the certificate is swapped atomically,
+         * so as that handshakes are not delayed by the loading;
+         * handshakes in progress and established connections keep their certificate,
+         * and the settings of the context, such as the session cache, are kept.
+         * @param certificate_file certificate file (normally has 'pem' extension); it may contain a certificate chain, after the certificate.
+         * @param key_file key file (normally has 'key' extension).
+         * @exception ssl_error thrown if the files cannot be loaded, or if the key does not match the certificate;
+         *  then, the current certificate is kept.
+         */
+        void load_certificate(const char* certificate_file, const char* key_file);
+
     protected:
         /**
          * Constructor.
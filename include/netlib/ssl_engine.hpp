@@ -0,0 +1,178 @@
+#ifndef NETLIB_SSL_ENGINE_HPP
+#define NETLIB_SSL_ENGINE_HPP
+
+
+#include <memory>
+#include <string>
+#include <cstddef>
+#include "ssl_context.hpp"
+#include "ssl_io_status.hpp"
+
+
+struct ssl_ctx_st;
+struct ssl_st;
+struct bio_st;
+
+
+namespace netlib::ssl {
+
+
+    /**
+     * TLS engine that is not bound to a socket.
+     * It encrypts and decrypts through memory buffers, so as that TLS can run over any transport:
+     * the encrypted data the transport receives are passed to the engine with write_input(),
+     * and the encrypted data the engine produces are taken with read_output(), then sent by the transport.
+     * Any operation may produce encrypted output (handshake messages, records, alerts);
+     * the output shall be taken and sent after each operation.
+     * The data are transferred as a byte stream; message boundaries are not preserved.
+     * Not thread-safe.
+     */
+    class engine {
+    public:
+        /**
+         * Role of the engine in the connection.
+         */
+        enum class role {
+            /**
+             * the engine initiates the handshake.
+             */
+            client,
+
+            /**
+             * the engine responds to the handshake.
+             */
+            server
+        };
+
+        /**
+         * Constructor.
+         * @param context context for creating the ssl object.
+         * @param r role of the engine.
+         * @param server_name for clients, the name of the server, sent with the server name indication extension; optional.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        engine(const context& context, role r, const std::string& server_name = std::string());
+
+        /**
+         * The object is not copyable.
+         */
+        engine(const engine&) = delete;
+
+        /**
+         * Move constructor.
+         */
+        engine(engine&&) = default;
+
+        /**
+         * The object is not copyable.
+         */
+        engine& operator = (const engine&) = delete;
+
+        /**
+         * Move assignment.
+         */
+        engine& operator = (engine&&) = default;
+
+        /**
+         * Returns the pointer to the SSL context.
+         */
+        const std::shared_ptr<ssl_ctx_st>& ctx() const {
+            return m_ctx;
+        }
+
+        /**
+         * Returns the connection pointer.
+         */
+        const std::shared_ptr<ssl_st>& ssl() const {
+            return m_ssl;
+        }
+
+        /**
+         * Checks if the handshake is complete.
+         */
+        bool is_handshake_complete() const;
+
+        /**
+         * Passes encrypted data received by the transport to the engine.
+         * @param data encrypted data.
+         * @param size number of bytes.
+         * @exception ssl_error thrown if the data could not be buffered.
+         */
+        void write_input(const char* data, size_t size);
+
+        /**
+         * Returns the number of encrypted bytes that are produced by the engine, but not taken yet.
+         */
+        size_t pending_output_size() const;
+
+        /**
+         * Takes encrypted data produced by the engine, to be sent by the transport.
+         * @param buffer destination buffer.
+         * @param capacity capacity of the destination buffer.
+         * @return number of bytes copied to the buffer; 0 if there are no pending data.
+         */
+        size_t read_output(char* buffer, size_t capacity);
+
+        /**
+         * Continues the handshake.
+         * @return io_status::done if the handshake is complete,
+         *  io_status::want_read if more input is needed, io_status::closed if the connection is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        io_status handshake();
+
+        /**
+         * Encrypts data; the encrypted records are appended to the pending output.
+         * If the handshake is not complete, it is continued first.
+         * @param data data to encrypt.
+         * @param size number of bytes.
+         * @return io_status::done if all the data are encrypted,
+         *  io_status::want_read if more input is needed for the handshake to complete, io_status::closed if the connection is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        io_status encrypt(const char* data, size_t size);
+
+        /**
+         * Decrypts the available input into the given buffer.
+         * If the handshake is not complete, it is continued first.
+         * @param buffer destination buffer.
+         * @param capacity capacity of the destination buffer.
+         * @param size number of decrypted bytes.
+         * @return io_status::done if data are decrypted, io_status::want_read if more input is needed,
+         *  io_status::closed if the other side has closed the connection.
+         * @exception std::invalid_argument thrown if the buffer is empty.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        io_status decrypt(char* buffer, size_t capacity, size_t& size);
+
+        /**
+         * Returns the number of decrypted bytes that are buffered by the engine, but not taken yet.
+         */
+        size_t pending_decrypted_size() const;
+
+        /**
+         * Continues the shutdown: it produces the close notification,
+         * then waits for the close notification of the other side, discarding any data decrypted before it.
+         * @return io_status::done if the shutdown is complete, io_status::want_read if more input is needed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        io_status shutdown();
+
+    private:
+        std::shared_ptr<ssl_ctx_st> m_ctx;
+        std::shared_ptr<ssl_st> m_ssl;
+
+        //memory bios; owned by the ssl object
+        bio_st* m_input;
+        bio_st* m_output;
+    };
+
+
+} //namespace netlib::ssl
+
+
+#endif //NETLIB_SSL_ENGINE_HPP
@@ -0,0 +1,22 @@
+#ifndef NETLIB_SSL_IO_STATUS_HPP
+#define NETLIB_SSL_IO_STATUS_HPP
+
+
+#include "io_status.hpp"
+
+
+namespace netlib::ssl {
+
+
+    /**
+     * Status of non-blocking ssl operations.
+     * It is the status of the non-blocking operations of unencrypted sockets;
+     * an ssl operation may also need the socket to be ready for writing while it receives, and vice versa.
+     */
+    using io_status = netlib::io_status;
+
+
+} //namespace netlib::ssl
+
+
+#endif //NETLIB_SSL_IO_STATUS_HPP
@@ -15,6 +15,9 @@ namespace netlib::ssl {
 
     /**
      * Base class for sll sockets.
+     * On systems without SO_NOSIGPIPE (e.g. Linux), the writes openssl does to the socket may raise SIGPIPE
+     * when the peer has closed the connection; applications that use ssl sockets shall ignore SIGPIPE,
+     * e.g. with signal(SIGPIPE, SIG_IGN), for such writes to fail instead of terminating the process.
      */
     class socket : public netlib::socket {
     public:
@@ -42,6 +45,16 @@ namespace netlib::ssl {
             return m_ssl;
         }
 
+        /**
+         * Checks if sent data are encrypted by the kernel.
+         */
+        bool is_kernel_tls_send_enabled() const;
+
+        /**
+         * Checks if received data are decrypted by the kernel.
+         */
+        bool is_kernel_tls_receive_enabled() const;
+
     protected:
         /**
          * Constructor.
@@ -2,14 +2,26 @@
 #define NETLIB_SSL_TCP_CLIENT_CONTEXT_HPP
 
 
+#include <cstddef>
 #include "ssl_context.hpp"
 
 
+/**
+ * Client session cache size preprocessor definition.
+ * Default max number of sessions a client context stores for resumption.
+ */
+#ifndef NETLIB_SSL_CLIENT_SESSION_CACHE_SIZE
+#define NETLIB_SSL_CLIENT_SESSION_CACHE_SIZE 256
+#endif
+
+
 namespace netlib::ssl::tcp {
 
 
     /**
      * Client context for tcp ssl sockets.
+     * It stores the sessions established with servers, by server address and server name,
+     * so as that reconnections to the same server resume the session with an abbreviated handshake.
      */
     class client_context : public ssl::context {
     public:
@@ -17,9 +29,21 @@ namespace netlib::ssl::tcp {
          * Constructor.
          * @param certificate_file certificate file (normally has 'pem' extension).
          * @param key_file key file (normally has 'key' extension).
+         * @param session_cache_size max number of sessions stored for resumption; if 0, sessions are not resumed.
          * @exception ssl_error thrown if there was an error.
          */
-        client_context(const char* certificate_file, const char* key_file);
+        client_context(const char* certificate_file, const char* key_file, size_t session_cache_size = NETLIB_SSL_CLIENT_SESSION_CACHE_SIZE);
+
+        /**
+         * Returns the number of stored sessions.
+         */
+        size_t session_count() const;
+
+        /**
+         * Removes the stored sessions;
+         * the next connections to servers do a full handshake.
+         */
+        void clear_sessions();
     };
 
 
@@ -3,8 +3,18 @@
 
 
 #include <optional>
+#include <string>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#if __has_include(<span>)
+#include <span>
+#endif
 #include "ssl_socket.hpp"
 #include "ssl_tcp_client_context.hpp"
+#include "ssl_io_status.hpp"
+#include "receive_buffer.hpp"
+#include "message_buffer.hpp"
 
 
 namespace netlib::ssl::tcp {
@@ -12,6 +22,10 @@ namespace netlib::ssl::tcp {
 
     /**
      * Client socket.
+     * A non-blocking socket is used with the non-blocking functions handshake(), send_non_blocking(), flush(),
+     * receive_non_blocking() and shutdown(), which return the event the socket shall be polled for,
+     * if they cannot complete without blocking; the blocking functions throw std::logic_error,
+     * if they would block on a non-blocking socket.
      */
     class client_socket : public ssl::socket {
     public:
@@ -24,17 +38,91 @@ namespace netlib::ssl::tcp {
         /**
          * Constructor.
          * It connects to the server both in the socket layer and in the ssl layer.
+         * Stored sessions are resumed by server address.
          * @param context context for creating the ssl object.
          * @param this_addr address to optionally bind this to.
          * @param server_addr server to connect to.
          * @param reuse_addr_and_port if set, then SO_REUSEADDR and SO_REUSEPORT (if available) are set on the socket.
+         * @param non_blocking if set, then the socket is non-blocking; the connection is started, but not waited for,
+         *  and the handshake is done by calling handshake(), until it returns io_status::done.
+         * @param options options set on the socket before it is connected.
          * @exception std::system_error thrown if there is a system error.
          * @exception ssl_error thrown if there is an ssl error.
          */
-        client_socket(const client_context& context, const std::optional<socket_address>& this_addr, const socket_address& server_addr, bool reuse_address_and_port = false);
+        client_socket(const client_context& context, const std::optional<socket_address>& this_addr, const socket_address& server_addr, bool reuse_address_and_port = false, bool non_blocking = false, const socket_options& options = {});
+
+        /**
+         * Constructor.
+         * It connects to the server both in the socket layer and in the ssl layer,
+         * sending the given server name with the server name indication extension.
+         * Stored sessions are resumed by server address and server name.
+         * @param context context for creating the ssl object.
+         * @param this_addr address to optionally bind this to.
+         * @param server_addr server to connect to.
+         * @param server_name name of the server.
+         * @param reuse_addr_and_port if set, then SO_REUSEADDR and SO_REUSEPORT (if available) are set on the socket.
+         * @param non_blocking if set, then the socket is non-blocking; the connection is started, but not waited for,
+         *  and the handshake is done by calling handshake(), until it returns io_status::done.
+         * @param options options set on the socket before it is connected.
+         * @exception std::system_error thrown if there is a system error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        client_socket(const client_context& context, const std::optional<socket_address>& this_addr, const socket_address& server_addr, const std::string& server_name, bool reuse_address_and_port = false, bool non_blocking = false, const socket_options& options = {});
+
+        /**
+         * Constructor with server name as a C string;
+         * it prevents the conversion of the server name to the parameter 'reuse_address_and_port' of the first constructor.
+         */
+        client_socket(const client_context& context, const std::optional<socket_address>& this_addr, const socket_address& server_addr, const char* server_name, bool reuse_address_and_port = false, bool non_blocking = false, const socket_options& options = {})
+            : client_socket(context, this_addr, server_addr, std::string(server_name), reuse_address_and_port, non_blocking, options)
+        {
+        }
+
+        /**
+         * Constructor with connection timeout.
+         * The connection and the handshake are done in non-blocking mode, so as that an unreachable server
+         * is not waited for more than the given time; after connecting, the socket is blocking.
+         * Stored sessions are resumed by server address and server name.
+         * @param context context for creating the ssl object.
+         * @param this_addr address to optionally bind this to.
+         * @param server_addr server to connect to.
+         * @param timeout max time to wait for the connection and the handshake.
+         * @param server_name name of the server, sent with the server name indication extension; optional.
+         * @param reuse_addr_and_port if set, then SO_REUSEADDR and SO_REUSEPORT (if available) are set on the socket.
+         * @param options options set on the socket before it is connected.
+         * @exception std::system_error thrown if there is a system error;
+         *  the error is the connection timeout error, if the timeout expires.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        client_socket(const client_context& context, const std::optional<socket_address>& this_addr, const socket_address& server_addr, std::chrono::milliseconds timeout, const std::string& server_name = std::string(), bool reuse_address_and_port = false, const socket_options& options = {});
+
+        /**
+         * Constructor from hostname, with connection timeout.
+         * All the addresses of the host are resolved, then connected to as in RFC 8305 ('Happy Eyeballs'):
+         * the attempts alternate between ip6 and ip4 addresses, a new attempt starts every NETLIB_TCP_CONNECTION_ATTEMPT_DELAY milliseconds,
+         * or as soon as the previous attempts fail, and the first attempt that succeeds is used for the handshake.
+         * The hostname is sent with the server name indication extension, unless it is an ip address string.
+         * After connecting, the socket is blocking.
+         * @param context context for creating the ssl object.
+         * @param hostname hostname/ip address string of server.
+         * @param port port of server.
+         * @param timeout max time to wait for the connection and the handshake.
+         * @param options options set on the socket before it is connected.
+         * @exception std::system_error thrown if there is a system error; if all the attempts fail, the error of the last attempt;
+         *  the error is the connection timeout error, if the timeout expires.
+         * @exception std::logic_error thrown if the hostname cannot be resolved to an IP4/IP6 address.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        client_socket(const client_context& context, const std::string& hostname, uint16_t port, std::chrono::milliseconds timeout, const socket_options& options = {});
+
+        /**
+         * Checks if the session was resumed from a previous connection, with an abbreviated handshake.
+         */
+        bool is_session_reused() const;
 
         /**
          * Sends data to the server.
+         * The size of the message is sent in the same tls record as the data.
          * @param data data to send.
          * @return true on success, false if the socket is closed.
          * @exception std::system_error thrown if there was an error.
@@ -43,6 +131,60 @@ namespace netlib::ssl::tcp {
          */
         bool send(const std::vector<char>& data);
 
+        /**
+         * Sends data to the server.
+         * The size of the message is sent in the same tls record as the data.
+         * @param data data to send.
+         * @param size number of bytes to send.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         * @exception bad_narrow_cast thrown if the size is greater than what message_size_t can store.
+         */
+        bool send(const char* data, size_t size);
+
+        /**
+         * Sends the data of a message buffer to the server.
+         * @param data data to send.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         * @exception bad_narrow_cast thrown if the buffer contains more bytes than what message_size_t can store.
+         */
+        bool send(const message_buffer& data) {
+            return send(data.data(), data.size());
+        }
+
+        /**
+         * Sends multiple messages to the server.
+         * The messages are packed into full tls records, so as that small messages
+         * share the encryption overhead and the system calls of a record.
+         * @param messages messages to send.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         * @exception bad_narrow_cast thrown if a message contains more bytes than what message_size_t can store.
+         */
+        bool send_batch(const std::vector<std::vector<char>>& messages);
+
+        #ifndef _WIN32
+        /**
+         * Sends the contents of a file to the server, as one message.
+         * If the data are encrypted by the kernel, the file is sent with sendfile,
+         * without being copied to user space; otherwise, it is read into a buffer,
+         * then sent through the ssl layer.
+         * @param file file descriptor.
+         * @param offset offset of the data in the file.
+         * @param size number of bytes to send.
+         * @return true on success, false if the socket is closed.
+         * @exception std::invalid_argument thrown if the file does not contain the given range.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         * @exception bad_narrow_cast thrown if the size is greater than what message_size_t can store.
+         */
+        bool send_file(int file, uint64_t offset, size_t size);
+        #endif
+
         /**
          * Receives data from the server.
          * @param data reception buffer.
@@ -52,7 +194,135 @@ namespace netlib::ssl::tcp {
          */
         bool receive(std::vector<char>& data);
 
+        /**
+         * Receives data from the server into the given buffer, without allocating memory.
+         * @param buffer reception buffer.
+         * @param capacity capacity of the reception buffer.
+         * @param size number of bytes received.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         * @exception std::length_error thrown if the message does not fit in the buffer; the message is discarded.
+         */
+        bool receive(char* buffer, size_t capacity, size_t& size);
+
+        #ifdef __cpp_lib_span
+        /**
+         * Receives data from the server into the given buffer, without allocating memory.
+         * @param buffer reception buffer.
+         * @param size number of bytes received.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         * @exception std::length_error thrown if the message does not fit in the buffer; the message is discarded.
+         */
+        bool receive(std::span<std::byte> buffer, size_t& size) {
+            return receive(reinterpret_cast<char*>(buffer.data()), buffer.size(), size);
+        }
+        #endif
+
+        /**
+         * Receives data from the server into a message buffer.
+         * The buffer is reused if it is not shared and the message fits in it;
+         * otherwise, a buffer of the message size is acquired.
+         * @param data reception buffer.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        bool receive(message_buffer& data);
+
+        /**
+         * Continues the ssl handshake of a non-blocking socket.
+         * @return io_status::done if the handshake is complete; otherwise, the status of the handshake.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        io_status handshake();
+
+        /**
+         * Sends data to the other side over a non-blocking socket.
+         * The message is queued, then the queued data are sent, as much as possible without blocking.
+         * @param data data to send.
+         * @return io_status::done if all the queued data are sent; otherwise, the status of the pending data,
+         *  which shall be sent by calling flush().
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         * @exception bad_narrow_cast thrown if the buffer contains more bytes than what message_size_t can store.
+         */
+        io_status send_non_blocking(const std::vector<char>& data);
+
+        /**
+         * Sends the queued data of a non-blocking socket, as much as possible without blocking.
+         * @return io_status::done if all the queued data are sent; otherwise, the status of the pending data.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        io_status flush();
+
+        /**
+         * Returns the number of queued bytes that are not sent yet.
+         */
+        size_t pending_send_size() const {
+            return m_send_buffer.size() - m_sent_size;
+        }
+
+        /**
+         * Receives data from the other side over a non-blocking socket.
+         * The available data are buffered, until a whole message is received.
+         * @param data reception buffer; set only if a message is received.
+         * @return io_status::done if a message is received; otherwise, the status of the reception.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        io_status receive_non_blocking(std::vector<char>& data);
+
+        /**
+         * Continues the ssl shutdown of a non-blocking socket:
+         * it sends the close notification, then waits for the close notification of the other side,
+         * discarding any data received before it.
+         * @return io_status::done if the shutdown is complete; otherwise, the status of the shutdown.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        io_status shutdown();
+
+        /**
+         * Returns the size of the receive buffer.
+         */
+        size_t receive_buffer_size() const {
+            return m_receive_buffer.capacity();
+        }
+
+        /**
+         * Sets the size of the receive buffer.
+         * @param size size of the receive buffer; if 0, received data are not buffered.
+         */
+        void set_receive_buffer_size(size_t size) {
+            m_receive_buffer.set_capacity(size);
+        }
+
+        /**
+         * Returns the number of received bytes that are buffered in the receive buffer,
+         * or that are decrypted by the ssl layer, but not read yet.
+         */
+        size_t buffered_receive_size() const override;
+
     private:
+        receive_buffer m_receive_buffer;
+
+        //partial tls record of send() and send_batch()
+        std::vector<char> m_record_buffer;
+
+        //data queued by send_non_blocking()
+        std::vector<char> m_send_buffer;
+
+        //number of bytes of the send buffer that are already sent
+        size_t m_sent_size{ 0 };
+
+        //if the connection of a non-blocking socket is not established yet
+        bool m_connecting{ false };
+
         //constructor from server_socket::accept().
         client_socket(const std::shared_ptr<ssl_ctx_st>& ctx, const std::shared_ptr<ssl_st>& ssl) : ssl::socket(ctx, ssl) {}
 
@@ -0,0 +1,57 @@
+#ifndef NETLIB_SSL_TCP_CONNECTION_POOL_HPP
+#define NETLIB_SSL_TCP_CONNECTION_POOL_HPP
+
+
+#include <memory>
+#include <string>
+#include "connection_pool.hpp"
+#include "ssl_tcp_client_socket.hpp"
+
+
+namespace netlib::ssl::tcp {
+
+
+    /**
+     * Pool of ssl tcp client connections, keyed by server address, context and server name.
+     * Reused connections skip both the connection and the handshake.
+     * Thread-safe class.
+     */
+    class connection_pool : public netlib::connection_pool {
+    public:
+        /**
+         * Constructor.
+         * @param options options.
+         * @exception std::invalid_argument thrown if max_total is 0.
+         */
+        connection_pool(const connection_pool_options& options = connection_pool_options());
+
+        /**
+         * Returns a connection to the given server: an idle connection, if there is a healthy one,
+         * otherwise a new connection, established and handshaken within the connect timeout.
+         * The connection returns to the pool when the last pointer to it is released.
+         * @param context context for creating new connections.
+         * @param server_addr address of server.
+         * @param server_name name of the server, sent with the server name indication extension; optional.
+         * @return connection.
+         * @exception std::system_error thrown if there is a system error;
+         *  the error is the connection timeout error, if no connection was available within the connect timeout.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        std::shared_ptr<client_socket> acquire(const client_context& context, const socket_address& server_addr, const std::string& server_name = std::string());
+
+    protected:
+        /**
+         * Checks if an idle connection can be reused.
+         * Tls records that do not carry application data (e.g. session tickets sent after the handshake)
+         * are processed, and do not make the connection unusable.
+         * @param s connection.
+         * @return true if the connection can be reused.
+         */
+        bool is_healthy(netlib::socket& s) const override;
+    };
+
+
+} //namespace netlib::ssl::tcp
+
+
+#endif //NETLIB_SSL_TCP_CONNECTION_POOL_HPP
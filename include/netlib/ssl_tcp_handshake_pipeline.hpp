@@ -0,0 +1,163 @@
+#ifndef NETLIB_SSL_TCP_HANDSHAKE_PIPELINE_HPP
+#define NETLIB_SSL_TCP_HANDSHAKE_PIPELINE_HPP
+
+
+#include <functional>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <exception>
+#include "socket_poller_group.hpp"
+#include "ssl_tcp_server_socket.hpp"
+
+
+/**
+ * Handshake timeout preprocessor definition.
+ * Default time, in milliseconds, a client has for completing the ssl handshake.
+ */
+#ifndef NETLIB_SSL_HANDSHAKE_TIMEOUT
+#define NETLIB_SSL_HANDSHAKE_TIMEOUT 10000
+#endif
+
+
+namespace netlib::ssl::tcp {
+
+
+    /**
+     * Handshake pipeline.
+     * It accepts the connections of a server socket without doing the ssl handshake on the accepting thread;
+     * the handshakes are done as non-blocking state machines, in a group of socket poller threads,
+     * so as that slow clients do not delay other clients, and the handshakes scale with the number of cores.
+     * The client sockets that complete the handshake are delivered through a callback;
+     * they are non-blocking sockets.
+     * The callbacks are invoked from the socket poller threads.
+     */
+    class handshake_pipeline {
+    public:
+        /**
+         * Client socket pointer type.
+         */
+        using client_socket_ptr = std::shared_ptr<client_socket>;
+
+        /**
+         * Completion callback type.
+         * It is invoked with a client socket that completed the handshake, and its address.
+         */
+        using completion_callback_type = std::function<void(const client_socket_ptr& s, const socket_address& addr)>;
+
+        /**
+         * Error callback type.
+         * It is invoked with the address of a client whose connection or handshake failed, or timed out, and the error.
+         */
+        using error_callback_type = std::function<void(const socket_address& addr, const std::exception_ptr& error)>;
+
+        /**
+         * Constructor.
+         * It starts accepting connections.
+         * @param server server socket.
+         * @param on_complete completion callback.
+         * @param on_error error callback; optional.
+         * @param thread_count number of socket poller threads; if 0, the number of hardware threads is used.
+         * @param timeout time a client has for completing the handshake.
+         * @exception std::invalid_argument thrown if the server socket or the completion callback is empty.
+         */
+        handshake_pipeline(const std::shared_ptr<server_socket>& server, const completion_callback_type& on_complete, const error_callback_type& on_error = nullptr, size_t thread_count = 0, std::chrono::milliseconds timeout = std::chrono::milliseconds(NETLIB_SSL_HANDSHAKE_TIMEOUT));
+
+        /**
+         * The object is not copyable.
+         */
+        handshake_pipeline(const handshake_pipeline&) = delete;
+
+        /**
+         * The object is not movable.
+         */
+        handshake_pipeline(handshake_pipeline&&) = delete;
+
+        /**
+         * Stops the pipeline.
+         */
+        ~handshake_pipeline();
+
+        /**
+         * The object is not copyable.
+         */
+        handshake_pipeline& operator = (const handshake_pipeline&) = delete;
+
+        /**
+         * The object is not movable.
+         */
+        handshake_pipeline& operator = (handshake_pipeline&&) = delete;
+
+        /**
+         * Returns the number of handshakes in progress.
+         */
+        size_t pending_handshake_count() const;
+
+        /**
+         * Stops accepting connections, and drops the handshakes in progress.
+         * Also invoked in the destructor.
+         */
+        void stop();
+
+    private:
+        //handshake in progress
+        struct handshake {
+            client_socket_ptr socket;
+            socket_address address;
+            std::chrono::steady_clock::time_point deadline;
+
+            //if a thread is doing a handshake step; if not set, the socket is waiting for a poller event
+            bool in_progress;
+        };
+
+        //server socket
+        std::shared_ptr<server_socket> m_server;
+
+        //callbacks
+        completion_callback_type m_on_complete;
+        error_callback_type m_on_error;
+
+        //handshake timeout
+        std::chrono::milliseconds m_timeout;
+
+        //mutex for synchronization
+        mutable std::mutex m_mutex;
+
+        //signals the timeout thread to stop
+        std::condition_variable m_stop_cond;
+
+        //if stopped
+        bool m_stop;
+
+        //handshakes in progress
+        std::unordered_map<client_socket*, handshake> m_handshakes;
+
+        //socket poller threads
+        socket_poller_group m_pollers;
+
+        //thread that drops the handshakes that timed out
+        std::thread m_timeout_thread;
+
+        //accepts a connection
+        void accept();
+
+        //invoked when a socket is ready for the next handshake step
+        void on_socket_ready(const client_socket_ptr& s);
+
+        //does a handshake step
+        void continue_handshake(const client_socket_ptr& s);
+
+        //drops the handshakes that timed out
+        void run_timeouts();
+
+        //invokes the error callback
+        void report_error(const socket_address& addr, const std::exception_ptr& error);
+    };
+
+
+} //namespace netlib::ssl::tcp
+
+
+#endif //NETLIB_SSL_TCP_HANDSHAKE_PIPELINE_HPP
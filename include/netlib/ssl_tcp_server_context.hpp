@@ -2,14 +2,37 @@
 #define NETLIB_SSL_TCP_SERVER_CONTEXT_HPP
 
 
+#include <cstddef>
+#include <chrono>
 #include "ssl_context.hpp"
 
 
+/**
+ * Server session cache size preprocessor definition.
+ * Default max number of sessions a server context stores for resumption with session ids.
+ */
+#ifndef NETLIB_SSL_SERVER_SESSION_CACHE_SIZE
+#define NETLIB_SSL_SERVER_SESSION_CACHE_SIZE 20480
+#endif
+
+
+/**
+ * Ticket key rotation interval preprocessor definition.
+ * Default interval, in seconds, after which a server context creates a new session ticket key.
+ */
+#ifndef NETLIB_SSL_TICKET_KEY_ROTATION_INTERVAL
+#define NETLIB_SSL_TICKET_KEY_ROTATION_INTERVAL 3600
+#endif
+
+
 namespace netlib::ssl::tcp {
 
 
     /**
      * Server context for tcp ssl sockets.
+     * Sessions are resumed either from the session cache of the context,
+     * or from session tickets, which are encrypted with keys that the context rotates periodically.
+     * Tickets encrypted with the previous key are accepted and renewed.
      */
     class server_context : public ssl::context {
     public:
@@ -20,6 +43,48 @@ namespace netlib::ssl::tcp {
          * @exception ssl_error thrown if there was an error.
          */
         server_context(const char* certificate_file, const char* key_file);
+
+        /**
+         * Returns the max number of sessions stored in the session cache.
+         */
+        size_t session_cache_size() const;
+
+        /**
+         * Sets the max number of sessions stored in the session cache.
+         * @param size max number of sessions; if 0, the session cache is disabled,
+         *  and sessions are resumed only from session tickets.
+         */
+        void set_session_cache_size(size_t size);
+
+        /**
+         * Returns the time a session can be resumed for.
+         */
+        std::chrono::seconds session_timeout() const;
+
+        /**
+         * Sets the time a session can be resumed for.
+         * @param timeout timeout.
+         */
+        void set_session_timeout(std::chrono::seconds timeout);
+
+        /**
+         * Returns the interval after which a new ticket key is created.
+         */
+        std::chrono::seconds ticket_key_rotation_interval() const;
+
+        /**
+         * Sets the interval after which a new ticket key is created.
+         * @param interval interval; if 0, ticket keys are rotated only by calling rotate_ticket_keys().
+         */
+        void set_ticket_key_rotation_interval(std::chrono::seconds interval);
+
+        /**
+         * Creates a new ticket key for encrypting session tickets.
+         * Tickets encrypted with the previous key are still accepted;
+         * tickets encrypted with older keys are not, and their sessions require a full handshake.
+         * @exception ssl_error thrown if there was an error.
+         */
+        void rotate_ticket_keys();
     };
 
 
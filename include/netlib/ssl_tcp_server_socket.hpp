@@ -27,19 +27,22 @@ namespace netlib::ssl::tcp {
          * @param context context.
          * @param this_addr address to bind the socket to.
          * @param backlog backlog; if 0, SOMAXCONN is used.
+         * @param options options set on the socket before it listens; the accepted sockets inherit them, on most systems.
          * @exception std::system_error thrown if there is a socket error.
          * @exception ssl_error thrown if there is an ssl error.
          */
-        server_socket(const server_context& context, const socket_address& this_addr, int backlog = 0);
+        server_socket(const server_context& context, const socket_address& this_addr, int backlog = 0, const socket_options& options = {});
 
         /**
          * Accepts a socket connection.
          * @param addr client address.
+         * @param non_blocking if set, then the client socket is non-blocking,
+         *  and the handshake is done by calling handshake() on it, until it returns io_status::done.
          * @return client socket.
          * @exception std::system_error thrown if there is a socket error.
          * @exception ssl_error thrown if there is an ssl error.
          */
-        std::shared_ptr<client_socket> accept(socket_address& addr);
+        std::shared_ptr<client_socket> accept(socket_address& addr, bool non_blocking = false);
 
     private:
         std::shared_ptr<ssl_ctx_st> m_ctx;
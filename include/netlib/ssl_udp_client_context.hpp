@@ -0,0 +1,29 @@
+#ifndef NETLIB_SSL_UDP_CLIENT_CONTEXT_HPP
+#define NETLIB_SSL_UDP_CLIENT_CONTEXT_HPP
+
+
+#include "ssl_context.hpp"
+
+
+namespace netlib::ssl::udp {
+
+
+    /**
+     * Client context for udp ssl (DTLS) sockets.
+     */
+    class client_context : public ssl::context {
+    public:
+        /**
+         * Constructor.
+         * @param certificate_file certificate file (normally has 'pem' extension).
+         * @param key_file key file (normally has 'key' extension).
+         * @exception ssl_error thrown if there was an error.
+         */
+        client_context(const char* certificate_file, const char* key_file);
+    };
+
+
+} //namespace netlib::ssl::udp
+
+
+#endif //NETLIB_SSL_UDP_CLIENT_CONTEXT_HPP
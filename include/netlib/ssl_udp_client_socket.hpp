@@ -0,0 +1,137 @@
+#ifndef NETLIB_SSL_UDP_CLIENT_SOCKET_HPP
+#define NETLIB_SSL_UDP_CLIENT_SOCKET_HPP
+
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#if __has_include(<span>)
+#include <span>
+#endif
+#include "ssl_socket.hpp"
+#include "ssl_udp_client_context.hpp"
+#include "udp.hpp"
+#include "message_buffer.hpp"
+
+
+namespace netlib::ssl::udp {
+
+
+    /**
+     * UDP ssl (DTLS) client socket.
+     * Each message is sent as one DTLS record, in one datagram;
+     * messages may be lost or reordered, as with unencrypted udp sockets,
+     * but they are encrypted and authenticated.
+     */
+    class client_socket : public ssl::socket {
+    public:
+        /**
+         * Empty client socket constructor.
+         */
+        client_socket() : ssl::socket() {
+        }
+
+        /**
+         * Constructor.
+         * It binds the socket, connects it to the server, then does the DTLS handshake,
+         * retransmitting the handshake messages that are lost.
+         * @param context context for creating the ssl object.
+         * @param this_addr address to bind this socket to.
+         * @param server_addr address of server.
+         * @param reuse_addr_and_port if set, then SO_REUSEADDR and SO_REUSEPORT (if available) are set on the socket.
+         * @exception std::system_error thrown if there is a system error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        client_socket(const client_context& context, const socket_address& this_addr, const socket_address& server_addr, bool reuse_address_and_port = false);
+
+        /**
+         * Sends data to the other side.
+         * @param data data to send; it shall fit in one datagram.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error, including if the data are too large for one record.
+         */
+        bool send(const std::vector<char>& data);
+
+        /**
+         * Sends data to the other side.
+         * @param data data to send.
+         * @param size number of bytes to send.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        bool send(const char* data, size_t size);
+
+        /**
+         * Sends the data of a message buffer to the other side.
+         * @param data data to send.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        bool send(const message_buffer& data) {
+            return send(data.data(), data.size());
+        }
+
+        /**
+         * Receives data from the other side.
+         * @param data reception buffer.
+         * @param max_message_size max number of bytes to receive.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        bool receive(std::vector<char>& data, const uint16_t max_message_size = NETLIB_UDP_MAX_MESSAGE_SIZE);
+
+        /**
+         * Receives data from the other side into the given buffer, without allocating memory.
+         * If the message does not fit in the buffer, the excess bytes are discarded.
+         * @param buffer reception buffer.
+         * @param capacity capacity of the reception buffer.
+         * @param size number of bytes received.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        bool receive(char* buffer, size_t capacity, size_t& size);
+
+        #ifdef __cpp_lib_span
+        /**
+         * Receives data from the other side into the given buffer, without allocating memory.
+         * If the message does not fit in the buffer, the excess bytes are discarded.
+         * @param buffer reception buffer.
+         * @param size number of bytes received.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        bool receive(std::span<std::byte> buffer, size_t& size) {
+            return receive(reinterpret_cast<char*>(buffer.data()), buffer.size(), size);
+        }
+        #endif
+
+        /**
+         * Receives data from the other side into a message buffer.
+         * The buffer is reused if it is not shared and it has the capacity for the max message size;
+         * otherwise, a buffer of the max message size is acquired.
+         * @param data reception buffer.
+         * @param max_message_size max number of bytes to receive.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        bool receive(message_buffer& data, const uint16_t max_message_size = NETLIB_UDP_MAX_MESSAGE_SIZE);
+
+    private:
+        //constructor from server_socket::accept().
+        client_socket(const std::shared_ptr<ssl_ctx_st>& ctx, const std::shared_ptr<ssl_st>& ssl) : ssl::socket(ctx, ssl) {}
+
+        friend class internal_client_socket;
+    };
+
+
+} //namespace netlib::ssl::udp
+
+
+#endif //NETLIB_SSL_UDP_CLIENT_SOCKET_HPP
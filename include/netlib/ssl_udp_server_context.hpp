@@ -0,0 +1,39 @@
+#ifndef NETLIB_SSL_UDP_SERVER_CONTEXT_HPP
+#define NETLIB_SSL_UDP_SERVER_CONTEXT_HPP
+
+
+#include "ssl_context.hpp"
+
+
+namespace netlib::ssl::udp {
+
+
+    /**
+     * Server context for udp ssl (DTLS) sockets.
+     * Clients must echo a cookie before the server creates any state for them;
+     * the cookie is an HMAC of the client address, keyed with a secret of the context,
+     * so as that clients with spoofed addresses cannot make the server allocate connections.
+     */
+    class server_context : public ssl::context {
+    public:
+        /**
+         * Constructor.
+         * @param certificate_file certificate file (normally has 'pem' extension).
+         * @param key_file key file (normally has 'key' extension).
+         * @exception ssl_error thrown if there was an error.
+         */
+        server_context(const char* certificate_file, const char* key_file);
+
+        /**
+         * Creates a new cookie secret.
+         * Cookies sent before the call become invalid; their clients must repeat the cookie exchange.
+         * @exception ssl_error thrown if there was an error.
+         */
+        void rotate_cookie_secret();
+    };
+
+
+} //namespace netlib::ssl::udp
+
+
+#endif //NETLIB_SSL_UDP_SERVER_CONTEXT_HPP
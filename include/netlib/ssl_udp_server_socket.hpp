@@ -0,0 +1,60 @@
+#ifndef NETLIB_SSL_UDP_SERVER_SOCKET_HPP
+#define NETLIB_SSL_UDP_SERVER_SOCKET_HPP
+
+
+#include "ssl_udp_server_context.hpp"
+#include "ssl_udp_client_socket.hpp"
+#include "unencrypted_socket.hpp"
+
+
+namespace netlib::ssl::udp {
+
+
+    /**
+     * UDP ssl (DTLS) server socket.
+     * The socket itself is an unencrypted socket, since it does not handle any data;
+     * it receives the first messages of the clients, and does the cookie exchange with them,
+     * without keeping any state.
+     * Clients that echo a valid cookie are accepted: a socket bound to the same address
+     * and connected to the client is created for each connection, with SO_REUSEADDR and SO_REUSEPORT (if available) set.
+     */
+    class server_socket : public unencrypted::socket {
+    public:
+        /**
+         * The default constructor.
+         */
+        server_socket() : unencrypted::socket() {
+        }
+
+        /**
+         * Creates a socket and binds it to the given address.
+         * SO_REUSEADDR and SO_REUSEPORT (if available) are set on the socket,
+         * since the sockets of the connections are bound to the same address.
+         * @param context context.
+         * @param this_addr address to bind the socket to.
+         * @exception std::system_error thrown if there is a socket error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        server_socket(const server_context& context, const socket_address& this_addr);
+
+        /**
+         * Waits for a client that echoes a valid cookie, then does the DTLS handshake with it.
+         * @param addr client address.
+         * @return client socket.
+         * @exception std::system_error thrown if there is a socket error.
+         * @exception ssl_error thrown if there is an ssl error.
+         */
+        std::shared_ptr<client_socket> accept(socket_address& addr);
+
+    private:
+        std::shared_ptr<ssl_ctx_st> m_ctx;
+
+        //address the socket is bound to
+        socket_address m_address;
+    };
+
+
+} //namespace netlib::ssl::udp
+
+
+#endif //NETLIB_SSL_UDP_SERVER_SOCKET_HPP
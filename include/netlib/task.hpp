@@ -0,0 +1,263 @@
+#ifndef NETLIB_TASK_HPP
+#define NETLIB_TASK_HPP
+
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+
+namespace netlib {
+
+
+    template <class T> class task;
+
+
+    /**
+     * Base class for the promise of tasks.
+     */
+    class task_promise_base {
+    public:
+        /**
+         * Tasks are lazy; they start when awaited or started.
+         */
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        /**
+         * On completion, the awaiting coroutine is resumed;
+         * a started task destroys itself.
+         */
+        auto final_suspend() noexcept {
+            return final_awaiter{};
+        }
+
+        /**
+         * Stores the exception, in order to be rethrown to the awaiting coroutine.
+         * A started task has no one to rethrow the exception to; it terminates the program.
+         */
+        void unhandled_exception() noexcept {
+            if (m_detached) {
+                std::terminate();
+            }
+            m_exception = std::current_exception();
+        }
+
+    protected:
+        //rethrows the exception of the task, if any
+        void rethrow_exception() const {
+            if (m_exception) {
+                std::rethrow_exception(m_exception);
+            }
+        }
+
+    private:
+        //resumes the awaiting coroutine, or destroys a started task
+        struct final_awaiter {
+            bool await_ready() noexcept {
+                return false;
+            }
+
+            template <class P> std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+                task_promise_base& promise = h.promise();
+                if (promise.m_detached) {
+                    h.destroy();
+                    return std::noop_coroutine();
+                }
+                return promise.m_continuation ? promise.m_continuation : std::noop_coroutine();
+            }
+
+            void await_resume() noexcept {
+            }
+        };
+
+        std::coroutine_handle<> m_continuation;
+        std::exception_ptr m_exception;
+        bool m_detached = false;
+
+        template <class T> friend class task;
+    };
+
+
+    /**
+     * Promise of tasks that return a value.
+     */
+    template <class T> class task_promise : public task_promise_base {
+    public:
+        /**
+         * Returns the task.
+         */
+        task<T> get_return_object() noexcept;
+
+        /**
+         * Stores the result.
+         */
+        template <class V> void return_value(V&& value) {
+            m_result.emplace(std::forward<V>(value));
+        }
+
+        /**
+         * Returns the result, or rethrows the exception of the task.
+         */
+        T result() {
+            rethrow_exception();
+            return std::move(*m_result);
+        }
+
+    private:
+        std::optional<T> m_result;
+    };
+
+
+    /**
+     * Promise of tasks that do not return a value.
+     */
+    template <> class task_promise<void> : public task_promise_base {
+    public:
+        /**
+         * Returns the task.
+         */
+        task<void> get_return_object() noexcept;
+
+        /**
+         * Completes the task.
+         */
+        void return_void() noexcept {
+        }
+
+        /**
+         * Rethrows the exception of the task, if any.
+         */
+        void result() {
+            rethrow_exception();
+        }
+    };
+
+
+    /**
+     * A coroutine that runs when awaited, or when started.
+     * Awaiting a task resumes the awaiting coroutine when the task completes,
+     * with the result of the task, or with the exception the task threw.
+     * @param T type of result.
+     */
+    template <class T = void> class task {
+    public:
+        using promise_type = task_promise<T>;
+
+        /**
+         * Constructor.
+         * @param h handle of the coroutine.
+         */
+        explicit task(std::coroutine_handle<promise_type> h = nullptr) noexcept : m_handle(h) {
+        }
+
+        /**
+         * The object is not copyable.
+         */
+        task(const task&) = delete;
+
+        /**
+         * Move constructor.
+         */
+        task(task&& t) noexcept : m_handle(std::exchange(t.m_handle, nullptr)) {
+        }
+
+        /**
+         * Destroys the coroutine, if not started.
+         */
+        ~task() {
+            if (m_handle) {
+                m_handle.destroy();
+            }
+        }
+
+        /**
+         * The object is not copyable.
+         */
+        task& operator = (const task&) = delete;
+
+        /**
+         * Move assignment.
+         */
+        task& operator = (task&& t) noexcept {
+            if (this != &t) {
+                if (m_handle) {
+                    m_handle.destroy();
+                }
+                m_handle = std::exchange(t.m_handle, nullptr);
+            }
+            return *this;
+        }
+
+        /**
+         * Checks if the task holds a coroutine.
+         */
+        explicit operator bool() const noexcept {
+            return static_cast<bool>(m_handle);
+        }
+
+        /**
+         * Starts the task, without awaiting it.
+         * The task runs until its first suspension point, then it continues
+         * on the thread that resumes it; it is destroyed when it completes.
+         * If the task throws, the program is terminated.
+         */
+        void start() {
+            if (m_handle) {
+                m_handle.promise().m_detached = true;
+                std::exchange(m_handle, nullptr).resume();
+            }
+        }
+
+        /**
+         * Awaits the task; the task starts, and the awaiting coroutine is resumed when the task completes.
+         */
+        auto operator co_await() && noexcept {
+            struct awaiter {
+                std::coroutine_handle<promise_type> handle;
+
+                bool await_ready() noexcept {
+                    return !handle;
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept {
+                    handle.promise().m_continuation = continuation;
+                    return handle;
+                }
+
+                T await_resume() {
+                    return handle.promise().result();
+                }
+            };
+            return awaiter{ m_handle };
+        }
+
+    private:
+        std::coroutine_handle<promise_type> m_handle;
+    };
+
+
+    //Returns the task.
+    template <class T> task<T> task_promise<T>::get_return_object() noexcept {
+        return task<T>(std::coroutine_handle<task_promise<T>>::from_promise(*this));
+    }
+
+
+    //Returns the task.
+    inline task<void> task_promise<void>::get_return_object() noexcept {
+        return task<void>(std::coroutine_handle<task_promise<void>>::from_promise(*this));
+    }
+
+
+} //namespace netlib
+
+
+#endif //defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+
+#endif //NETLIB_TASK_HPP
@@ -4,7 +4,27 @@
 
 #include <vector>
 #include <optional>
+#include <string>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#if __has_include(<span>)
+#include <span>
+#endif
 #include "unencrypted_socket.hpp"
+#include "io_status.hpp"
+#include "receive_buffer.hpp"
+#include "message_buffer.hpp"
+
+
+/**
+ * TCP connection attempt delay preprocessor definition.
+ * Time, in milliseconds, to wait for a connection attempt to a server address,
+ * before an attempt to the next address of the server starts in parallel (RFC 8305).
+ */
+#ifndef NETLIB_TCP_CONNECTION_ATTEMPT_DELAY
+#define NETLIB_TCP_CONNECTION_ATTEMPT_DELAY 250
+#endif
 
 
 namespace netlib::unencrypted::tcp {
@@ -35,9 +55,40 @@ namespace netlib::unencrypted::tcp {
          * @param this_addr address to optionally bind this socket to.
          * @param server_addr address of server.
          * @param reuse_addr_and_port if set, then SO_REUSEADDR and SO_REUSEPORT (if available) are set on the socket.
+         * @param options options set on the socket before it is connected.
          * @exception std::system_error if a system error has occurred.
          */
-        client_socket(const std::optional<socket_address>& this_addr, const socket_address& server_addr, bool reuse_address_and_port = false);
+        client_socket(const std::optional<socket_address>& this_addr, const socket_address& server_addr, bool reuse_address_and_port = false, const socket_options& options = {});
+
+        /**
+         * Constructor with connection timeout.
+         * The connection is done in non-blocking mode, so as that an unreachable server is not waited for
+         * more than the given time; after connecting, the socket is blocking.
+         * @param this_addr address to optionally bind this socket to.
+         * @param server_addr address of server.
+         * @param timeout max time to wait for the connection.
+         * @param reuse_addr_and_port if set, then SO_REUSEADDR and SO_REUSEPORT (if available) are set on the socket.
+         * @param options options set on the socket before it is connected.
+         * @exception std::system_error if a system error has occurred;
+         *  the error is the connection timeout error, if the timeout expires.
+         */
+        client_socket(const std::optional<socket_address>& this_addr, const socket_address& server_addr, std::chrono::milliseconds timeout, bool reuse_address_and_port = false, const socket_options& options = {});
+
+        /**
+         * Constructor from hostname, with connection timeout.
+         * All the addresses of the host are resolved, then connected to as in RFC 8305 ('Happy Eyeballs'):
+         * the attempts alternate between ip6 and ip4 addresses, a new attempt starts every NETLIB_TCP_CONNECTION_ATTEMPT_DELAY milliseconds,
+         * or as soon as the previous attempts fail, and the first attempt that succeeds is used.
+         * After connecting, the socket is blocking.
+         * @param hostname hostname/ip address string of server.
+         * @param port port of server.
+         * @param timeout max time to wait for the connection.
+         * @param options options set on the socket before it is connected.
+         * @exception std::system_error if a system error has occurred; if all the attempts fail, the error of the last attempt;
+         *  the error is the connection timeout error, if the timeout expires.
+         * @exception std::logic_error if the hostname cannot be resolved to an IP4/IP6 address.
+         */
+        client_socket(const std::string& hostname, uint16_t port, std::chrono::milliseconds timeout, const socket_options& options = {});
 
         /**
          * Sends data to the server.
@@ -48,6 +99,37 @@ namespace netlib::unencrypted::tcp {
          */
         bool send(const std::vector<char>& data);
 
+        /**
+         * Sends data to the server.
+         * @param data data to send.
+         * @param size number of bytes to send.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception bad_narrow_cast thrown if the size is greater than what message_size_t can store.
+         */
+        bool send(const char* data, size_t size);
+
+        /**
+         * Sends the data of a message buffer to the server, without copying them.
+         * @param data data to send.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception bad_narrow_cast thrown if the buffer contains more bytes than what message_size_t can store.
+         */
+        bool send(const message_buffer& data) {
+            return send(data.data(), data.size());
+        }
+
+        /**
+         * Sends multiple messages to the server.
+         * The messages are sent with as few system calls as possible.
+         * @param messages messages to send.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception bad_narrow_cast thrown if a message contains more bytes than what message_size_t can store.
+         */
+        bool send_batch(const std::vector<std::vector<char>>& messages);
+
         /**
          * Receives data from the server.
          * @param data reception buffer.
@@ -55,6 +137,103 @@ namespace netlib::unencrypted::tcp {
          * @exception std::system_error thrown if there was an error.
          */
         bool receive(std::vector<char>& data);
+
+        /**
+         * Receives data from the server into the given buffer, without allocating memory.
+         * @param buffer reception buffer.
+         * @param capacity capacity of the reception buffer.
+         * @param size number of bytes received.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception std::length_error thrown if the message does not fit in the buffer; the message is discarded.
+         */
+        bool receive(char* buffer, size_t capacity, size_t& size);
+
+        #ifdef __cpp_lib_span
+        /**
+         * Receives data from the server into the given buffer, without allocating memory.
+         * @param buffer reception buffer.
+         * @param size number of bytes received.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception std::length_error thrown if the message does not fit in the buffer; the message is discarded.
+         */
+        bool receive(std::span<std::byte> buffer, size_t& size) {
+            return receive(reinterpret_cast<char*>(buffer.data()), buffer.size(), size);
+        }
+        #endif
+
+        /**
+         * Receives data from the server into a message buffer.
+         * The buffer is reused if it is not shared and the message fits in it;
+         * otherwise, a buffer of the message size is acquired.
+         * @param data reception buffer.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         */
+        bool receive(message_buffer& data);
+
+        /**
+         * Sends data to the server, without blocking; for non-blocking sockets.
+         * As much of the message as possible is sent; if the socket cannot take all of it, the function shall be invoked again
+         * with the same data and offset, when the socket is ready for writing, until it returns io_status::done.
+         * @param data data to send; they must stay valid until the message is sent.
+         * @param size number of bytes to send.
+         * @param offset number of bytes of the message, including its size, that have been sent; it shall be 0 for a new message.
+         * @return io_status::done if the message is sent, io_status::want_write if the socket shall be polled for writing,
+         *  io_status::closed if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception bad_narrow_cast thrown if the size is greater than what message_size_t can store.
+         */
+        io_status send_non_blocking(const char* data, size_t size, size_t& offset);
+
+        /**
+         * Sends data to the server, without blocking; for non-blocking sockets.
+         * @param data data to send; they must stay valid until the message is sent.
+         * @param offset number of bytes of the message, including its size, that have been sent; it shall be 0 for a new message.
+         * @return io_status::done if the message is sent, io_status::want_write if the socket shall be polled for writing,
+         *  io_status::closed if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         * @exception bad_narrow_cast thrown if the buffer contains more bytes than what message_size_t can store.
+         */
+        io_status send_non_blocking(const std::vector<char>& data, size_t& offset) {
+            return send_non_blocking(data.data(), data.size(), offset);
+        }
+
+        /**
+         * Receives data from the server, without blocking; for non-blocking sockets.
+         * The bytes of a partially received message are kept in the receive buffer, until the whole message is received.
+         * @param data reception buffer.
+         * @return io_status::done if a message is received, io_status::want_read if the socket shall be polled for reading,
+         *  io_status::closed if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         */
+        io_status receive_non_blocking(std::vector<char>& data);
+
+        /**
+         * Returns the size of the receive buffer.
+         */
+        size_t receive_buffer_size() const {
+            return m_receive_buffer.capacity();
+        }
+
+        /**
+         * Sets the size of the receive buffer.
+         * @param size size of the receive buffer; if 0, received data are not buffered.
+         */
+        void set_receive_buffer_size(size_t size) {
+            m_receive_buffer.set_capacity(size);
+        }
+
+        /**
+         * Returns the number of received bytes that are buffered in the receive buffer.
+         */
+        size_t buffered_receive_size() const override {
+            return m_receive_buffer.size();
+        }
+
+    private:
+        receive_buffer m_receive_buffer;
     }; 
 
 
@@ -0,0 +1,42 @@
+#ifndef NETLIB_UNENCRYPTED_TCP_CONNECTION_POOL_HPP
+#define NETLIB_UNENCRYPTED_TCP_CONNECTION_POOL_HPP
+
+
+#include <memory>
+#include "connection_pool.hpp"
+#include "unencrypted_tcp_client_socket.hpp"
+
+
+namespace netlib::unencrypted::tcp {
+
+
+    /**
+     * Pool of tcp client connections, keyed by server address.
+     * Thread-safe class.
+     */
+    class connection_pool : public netlib::connection_pool {
+    public:
+        /**
+         * Constructor.
+         * @param options options.
+         * @exception std::invalid_argument thrown if max_total is 0.
+         */
+        connection_pool(const connection_pool_options& options = connection_pool_options());
+
+        /**
+         * Returns a connection to the given server: an idle connection, if there is a healthy one,
+         * otherwise a new connection, established within the connect timeout.
+         * The connection returns to the pool when the last pointer to it is released.
+         * @param server_addr address of server.
+         * @return connection.
+         * @exception std::system_error thrown if there is a system error;
+         *  the error is the connection timeout error, if no connection was available within the connect timeout.
+         */
+        std::shared_ptr<client_socket> acquire(const socket_address& server_addr);
+    };
+
+
+} //namespace netlib::unencrypted::tcp
+
+
+#endif //NETLIB_UNENCRYPTED_TCP_CONNECTION_POOL_HPP
@@ -2,6 +2,7 @@
 #define NETLIB_UNENCRYPTED_TCP_SERVER_SOCKET_HPP
 
 
+#include <memory>
 #include "unencrypted_tcp_client_socket.hpp"
 
 
@@ -32,9 +33,10 @@ namespace netlib::unencrypted::tcp {
          * Creates a socket, binds it to the given address, and listens for connections.
          * @param this_addr address to bind the socket to.
          * @param backlog backlog; if 0, SOMAXCONN is used.
+         * @param options options set on the socket before it listens; the accepted sockets inherit them, on most systems.
          * @exception std::system_error thrown if there is an error.
          */
-        server_socket(const socket_address& this_addr, int backlog = 0);
+        server_socket(const socket_address& this_addr, int backlog = 0, const socket_options& options = {});
 
         /**
          * Accepts a socket connection.
@@ -3,8 +3,13 @@
 
 
 #include <vector>
+#include <cstddef>
+#if __has_include(<span>)
+#include <span>
+#endif
 #include "unencrypted_socket.hpp"
 #include "udp.hpp"
+#include "message_buffer.hpp"
 
 
 namespace netlib::unencrypted::udp {
@@ -48,6 +53,25 @@ namespace netlib::unencrypted::udp {
          */
         bool send(const std::vector<char>& data);
 
+        /**
+         * Sends data to the server.
+         * @param data data to send.
+         * @param size number of bytes to send.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         */
+        bool send(const char* data, size_t size);
+
+        /**
+         * Sends the data of a message buffer to the server.
+         * @param data data to send.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         */
+        bool send(const message_buffer& data) {
+            return send(data.data(), data.size());
+        }
+
         /**
          * Receives data from the server.
          * @param data reception buffer.
@@ -55,6 +79,78 @@ namespace netlib::unencrypted::udp {
          * @exception std::system_error thrown if there was an error.
          */
         bool receive(std::vector<char>& data, const uint16_t max_message_size = NETLIB_UDP_MAX_MESSAGE_SIZE);
+
+        /**
+         * Receives data from the server into the given buffer, without allocating memory.
+         * If the datagram does not fit in the buffer, the excess bytes are discarded.
+         * @param buffer reception buffer.
+         * @param capacity capacity of the reception buffer.
+         * @param size number of bytes received.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         */
+        bool receive(char* buffer, size_t capacity, size_t& size);
+
+        #ifdef __cpp_lib_span
+        /**
+         * Receives data from the server into the given buffer, without allocating memory.
+         * If the datagram does not fit in the buffer, the excess bytes are discarded.
+         * @param buffer reception buffer.
+         * @param size number of bytes received.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         */
+        bool receive(std::span<std::byte> buffer, size_t& size) {
+            return receive(reinterpret_cast<char*>(buffer.data()), buffer.size(), size);
+        }
+        #endif
+
+        /**
+         * Receives data from the server into a message buffer.
+         * The buffer is reused if it is not shared and it has the capacity for the max message size;
+         * otherwise, a buffer of the max message size is acquired.
+         * @param data reception buffer.
+         * @param max_message_size max number of bytes to receive.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         */
+        bool receive(message_buffer& data, const uint16_t max_message_size = NETLIB_UDP_MAX_MESSAGE_SIZE);
+
+        /**
+         * Enables or disables generic receive offload.
+         * When enabled, consecutive datagrams from the same sender may be received
+         * with one call to receive_segments(), coalesced into one buffer.
+         * @param enabled if set, the offload is enabled, otherwise it is disabled.
+         * @return true on success, false if the offload is not supported.
+         */
+        bool set_receive_offload(bool enabled);
+
+        /**
+         * Sends data as datagrams of the given segment size; the last datagram may be smaller.
+         * Where UDP segmentation offload is available, up to 64 datagrams are passed to the kernel with one system call;
+         * otherwise, the datagrams are sent one by one.
+         * @param data data to send.
+         * @param size number of bytes to send.
+         * @param segment_size number of bytes of each datagram.
+         * @return true on success, false if the socket is closed.
+         * @exception std::invalid_argument thrown if the segment size is 0.
+         * @exception std::system_error thrown if there was an error.
+         */
+        bool send_segments(const char* data, size_t size, size_t segment_size);
+
+        /**
+         * Receives data from the server.
+         * If generic receive offload is enabled, multiple datagrams of the same size may be received, coalesced into the buffer;
+         * each datagram is one segment of the given segment size, except for the last one, which may be smaller.
+         * The capacity of the buffer should be NETLIB_UDP_MAX_MESSAGE_SIZE, otherwise coalesced datagrams may be truncated.
+         * @param buffer reception buffer.
+         * @param capacity capacity of the reception buffer.
+         * @param size number of bytes received.
+         * @param segment_size number of bytes of each segment; if the data are one datagram, it is equal to size.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         */
+        bool receive_segments(char* buffer, size_t capacity, size_t& size, size_t& segment_size);
     }; 
 
 
@@ -3,13 +3,44 @@
 
 
 #include <vector>
+#include <cstddef>
+#if __has_include(<span>)
+#include <span>
+#endif
 #include "unencrypted_socket.hpp"
 #include "udp.hpp"
+#include "message_buffer.hpp"
 
 
 namespace netlib::unencrypted::udp {
 
 
+    /**
+     * Datagram slot for batch operations.
+     */
+    struct datagram {
+        /**
+         * for send operations, the data to send; for receive operations, the reception buffer.
+         */
+        char* buffer;
+
+        /**
+         * capacity of the reception buffer; not used by send operations.
+         */
+        size_t capacity;
+
+        /**
+         * for send operations, the number of bytes to send; for receive operations, the number of bytes received.
+         */
+        size_t size;
+
+        /**
+         * for send operations, the address of the receiver; for receive operations, the address of the sender.
+         */
+        socket_address address;
+    };
+
+
     /**
      * UDP socket.
      */
@@ -57,6 +88,27 @@ namespace netlib::unencrypted::udp {
          */
         bool send(const std::vector<char>& data, const socket_address& receiver_addr);
 
+        /**
+         * Sends data to the given address.
+         * @param data data to send.
+         * @param size number of bytes to send.
+         * @param receiver_addr address to send the data to.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         */
+        bool send(const char* data, size_t size, const socket_address& receiver_addr);
+
+        /**
+         * Sends the data of a message buffer to the given address.
+         * @param data data to send.
+         * @param receiver_addr address to send the data to.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         */
+        bool send(const message_buffer& data, const socket_address& receiver_addr) {
+            return send(data.data(), data.size(), receiver_addr);
+        }
+
         /**
          * Receives data from the network.
          * @param data reception buffer.
@@ -66,6 +118,107 @@ namespace netlib::unencrypted::udp {
          * @exception std::system_error thrown if there was an error.
          */
         bool receive(std::vector<char>& data, socket_address& sender_addr, const uint16_t max_message_size = NETLIB_UDP_MAX_MESSAGE_SIZE);
+
+        /**
+         * Receives data from the network into the given buffer, without allocating memory.
+         * If the datagram does not fit in the buffer, the excess bytes are discarded.
+         * @param buffer reception buffer.
+         * @param capacity capacity of the reception buffer.
+         * @param size number of bytes received.
+         * @param sender_addr address of sender.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         */
+        bool receive(char* buffer, size_t capacity, size_t& size, socket_address& sender_addr);
+
+        #ifdef __cpp_lib_span
+        /**
+         * Receives data from the network into the given buffer, without allocating memory.
+         * If the datagram does not fit in the buffer, the excess bytes are discarded.
+         * @param buffer reception buffer.
+         * @param size number of bytes received.
+         * @param sender_addr address of sender.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         */
+        bool receive(std::span<std::byte> buffer, size_t& size, socket_address& sender_addr) {
+            return receive(reinterpret_cast<char*>(buffer.data()), buffer.size(), size, sender_addr);
+        }
+        #endif
+
+        /**
+         * Receives data from the network into a message buffer.
+         * The buffer is reused if it is not shared and it has the capacity for the max message size;
+         * otherwise, a buffer of the max message size is acquired.
+         * @param data reception buffer.
+         * @param sender_addr address of sender.
+         * @param max_message_size max number of bytes to receive.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         */
+        bool receive(message_buffer& data, socket_address& sender_addr, const uint16_t max_message_size = NETLIB_UDP_MAX_MESSAGE_SIZE);
+
+        /**
+         * Sends multiple datagrams, with as few system calls as possible.
+         * Where sendmmsg is not available, the datagrams are sent one by one.
+         * @param datagrams datagrams to send; the member 'capacity' is not used.
+         * @param count number of datagrams.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         */
+        bool send_batch(const datagram* datagrams, size_t count);
+
+        /**
+         * Receives multiple datagrams, with as few system calls as possible.
+         * It blocks until at least one datagram is received,
+         * then it receives the datagrams that are already available, up to the given count.
+         * Where recvmmsg is not available, the datagrams are received one by one.
+         * If a datagram does not fit in its buffer, the excess bytes are discarded.
+         * @param datagrams datagram slots to fill; the members 'buffer' and 'capacity' must be set by the caller.
+         * @param count number of datagram slots.
+         * @return number of datagrams received; 0 if the socket is closed.
+         * @exception std::invalid_argument thrown if there are no datagram slots.
+         * @exception std::system_error thrown if there was an error.
+         */
+        size_t receive_batch(datagram* datagrams, size_t count);
+
+        /**
+         * Enables or disables generic receive offload.
+         * When enabled, consecutive datagrams from the same sender may be received
+         * with one call to receive_segments(), coalesced into one buffer.
+         * @param enabled if set, the offload is enabled, otherwise it is disabled.
+         * @return true on success, false if the offload is not supported.
+         */
+        bool set_receive_offload(bool enabled);
+
+        /**
+         * Sends data as datagrams of the given segment size; the last datagram may be smaller.
+         * Where UDP segmentation offload is available, up to 64 datagrams are passed to the kernel with one system call;
+         * otherwise, the datagrams are sent one by one.
+         * @param data data to send.
+         * @param size number of bytes to send.
+         * @param segment_size number of bytes of each datagram.
+         * @param receiver_addr address to send the data to.
+         * @return true on success, false if the socket is closed.
+         * @exception std::invalid_argument thrown if the segment size is 0.
+         * @exception std::system_error thrown if there was an error.
+         */
+        bool send_segments(const char* data, size_t size, size_t segment_size, const socket_address& receiver_addr);
+
+        /**
+         * Receives data from the network.
+         * If generic receive offload is enabled, multiple datagrams of the same size may be received, coalesced into the buffer;
+         * each datagram is one segment of the given segment size, except for the last one, which may be smaller.
+         * The capacity of the buffer should be NETLIB_UDP_MAX_MESSAGE_SIZE, otherwise coalesced datagrams may be truncated.
+         * @param buffer reception buffer.
+         * @param capacity capacity of the reception buffer.
+         * @param size number of bytes received.
+         * @param segment_size number of bytes of each segment; if the data are one datagram, it is equal to size.
+         * @param sender_addr address of sender.
+         * @return true on success, false if the socket is closed.
+         * @exception std::system_error thrown if there was an error.
+         */
+        bool receive_segments(char* buffer, size_t capacity, size_t& size, size_t& segment_size, socket_address& sender_addr);
     };
 
 
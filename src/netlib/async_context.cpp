@@ -0,0 +1,289 @@
+#include "platform.hpp"
+#include "netlib/async_context.hpp"
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <stdexcept>
+#include <system_error>
+#include "netlib/ssl_error.hpp"
+
+
+namespace netlib {
+
+
+    //checks if a socket is ready for the given event, without waiting
+    static bool poll_socket(socket::handle_type handle, socket_poller::event_type e) {
+        pollfd pfd{};
+        pfd.fd = handle;
+        pfd.events = e == socket_poller::event_type::read ? POLLIN : POLLOUT;
+        return poll(&pfd, 1, 0) > 0 && pfd.revents;
+    }
+
+
+    //Checks if the socket of the operation is ready.
+    bool async_context::operation::is_ready(event_type e) const {
+        return m_ready || poll_socket(m_socket->handle(), e);
+    }
+
+
+    //continues the operation; an exception completes it
+    bool async_context::operation::run() {
+        bool complete;
+        try {
+            complete = step();
+        }
+        catch (...) {
+            m_error = std::current_exception();
+            complete = true;
+        }
+        m_ready = false;
+        return complete;
+    }
+
+
+    //invoked when the socket the operation waits for is ready
+    void async_context::operation::resume() {
+        m_ready = m_wait_socket == m_socket;
+
+        //complete
+        if (run()) {
+            m_handle.resume();
+            return;
+        }
+
+        //wait again; if the socket cannot be registered, complete with the error
+        try {
+            m_context.wait(*this);
+        }
+        catch (...) {
+            m_error = std::current_exception();
+            m_handle.resume();
+        }
+    }
+
+
+    //Constructor.
+    async_context::async_context(socket_poller& poller) : m_poller(poller) {
+    }
+
+
+    //Removes the registered sockets.
+    async_context::~async_context() {
+        std::lock_guard lock(m_mutex);
+        for (auto& [s, st] : m_sockets) {
+            try {
+                unregister(st);
+            }
+            catch (...) {
+            }
+        }
+    }
+
+
+    //Removes a socket from the socket poller.
+    void async_context::remove(const socket_ptr& s) {
+        std::lock_guard lock(m_mutex);
+        auto it = m_sockets.find(s.get());
+        if (it != m_sockets.end()) {
+            unregister(it->second);
+            m_sockets.erase(it);
+        }
+    }
+
+
+    //registers the operation to wait for its socket
+    void async_context::wait(operation& op) {
+        const socket_ptr s = op.m_wait_socket;
+        const event_type e = op.m_wait_event;
+        const size_t index = static_cast<size_t>(e);
+        const size_t other_index = 1 - index;
+
+        std::lock_guard lock(m_mutex);
+
+        //find or create the registration of the socket;
+        //it is kept after the operation, so as that later operations do not allocate
+        auto [it, inserted] = m_sockets.try_emplace(s.get());
+        socket_state& st = it->second;
+        if (inserted) {
+            st.socket = s;
+        }
+
+        //only one operation per socket and event
+        if (st.waiters[index]) {
+            throw std::logic_error("An operation is already pending for the socket.");
+        }
+
+        //register the event
+        if (!st.registered[index]) {
+            //an entry without an operation would wake up the poller for nothing
+            if (st.registered[other_index] && !st.waiters[other_index]) {
+                m_poller.remove(s, static_cast<event_type>(other_index));
+                st.registered[other_index] = false;
+            }
+
+            const bool added = m_poller.add(s, e, [this](socket_poller&, const socket_ptr& s, event_type e, socket_poller::status_flags) {
+                on_socket_ready(s, e);
+                }, socket_poller::registration_mode::one_shot);
+
+            if (!added) {
+                if (!st.registered[other_index]) {
+                    m_sockets.erase(it);
+                }
+                throw std::runtime_error("Socket poller is full.");
+            }
+
+            st.registered[index] = true;
+        }
+
+        //enable the entries of the socket; the callback cannot run before the operation is set, due to the mutex
+        m_poller.rearm(s);
+        st.waiters[index] = &op;
+    }
+
+
+    //invoked when the socket poller reports a socket as ready
+    void async_context::on_socket_ready(const socket_ptr& s, event_type e) {
+        operation* op;
+
+        {
+            std::lock_guard lock(m_mutex);
+
+            auto it = m_sockets.find(s.get());
+            if (it == m_sockets.end()) {
+                return;
+            }
+
+            socket_state& st = it->second;
+            const size_t index = static_cast<size_t>(e);
+            const size_t other_index = 1 - index;
+
+            op = st.waiters[index];
+            st.waiters[index] = nullptr;
+
+            //the one-shot entries of the socket are disabled; re-enable them for the operation that still waits
+            if (st.waiters[other_index]) {
+                if (!op && st.registered[index]) {
+                    m_poller.remove(s, e);
+                    st.registered[index] = false;
+                }
+                m_poller.rearm(s);
+            }
+        }
+
+        if (op) {
+            op->resume();
+        }
+    }
+
+
+    //removes a socket from the socket poller
+    void async_context::unregister(socket_state& st) {
+        if (st.registered[0] || st.registered[1]) {
+            st.registered[0] = st.registered[1] = false;
+            m_poller.remove(st.socket);
+        }
+    }
+
+
+    //converts the status of a non-blocking operation to the result of a step
+    bool async_context::complete(operation& op, io_status status, bool& result) {
+        switch (status) {
+        case io_status::want_read:
+            return op.wait(event_type::read);
+        case io_status::want_write:
+            return op.wait(event_type::write);
+        case io_status::closed:
+            result = false;
+            return true;
+        default:
+            result = true;
+            return true;
+        }
+    }
+
+
+    //accepts a connection; the client socket is non-blocking
+    std::shared_ptr<unencrypted::tcp::client_socket> async_context::accept_connection(unencrypted::tcp::server_socket& s, socket_address& addr) {
+        auto client = s.accept(addr);
+        if (set_socket_non_blocking(client->handle(), true)) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+        return client;
+    }
+
+
+    //creates a socket that is connecting in non-blocking mode
+    std::shared_ptr<unencrypted::tcp::client_socket> async_context::create_connecting_socket(const socket_address& server_addr) {
+        const socket::handle_type handle = ::socket(server_addr.address_family(), SOCK_STREAM, IPPROTO_TCP);
+        if (handle == socket::invalid_handle) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+
+        auto s = std::make_shared<unencrypted::tcp::client_socket>(handle);
+
+        if (set_socket_non_blocking(handle, true)) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+
+        if (::connect(handle, reinterpret_cast<const sockaddr*>(server_addr.data()), sizeof(sockaddr_storage))) {
+            const int error = get_last_error_number();
+            if (!is_operation_in_progress_error(error)) {
+                throw std::system_error(error, std::system_category());
+            }
+        }
+
+        return s;
+    }
+
+
+    //continues a connection
+    bool async_context::continue_connect(operation& op, const std::shared_ptr<unencrypted::tcp::client_socket>& s) {
+        try {
+            if (!op.is_ready(event_type::write)) {
+                return op.wait(event_type::write);
+            }
+
+            //get the result of the connection
+            int error = 0;
+            socklen_t error_length = sizeof(error);
+            if (getsockopt(s->handle(), SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &error_length)) {
+                throw std::system_error(get_last_error_number(), std::system_category());
+            }
+            if (error) {
+                throw std::system_error(error, std::system_category());
+            }
+
+            //the socket stays non-blocking, for the non-blocking operations
+            return true;
+        }
+        catch (...) {
+            remove(s);
+            throw;
+        }
+    }
+
+
+    //continues a handshake
+    bool async_context::continue_handshake(operation& op, const std::shared_ptr<ssl::tcp::client_socket>& s) {
+        try {
+            //the socket may not be the socket of the operation, e.g. on accept
+            switch (s->handshake()) {
+            case ssl::io_status::want_read:
+                return op.wait(s, event_type::read);
+            case ssl::io_status::want_write:
+                return op.wait(s, event_type::write);
+            case ssl::io_status::closed:
+                throw ssl::error("Connection closed during the handshake.");
+            default:
+                return true;
+            }
+        }
+        catch (...) {
+            remove(s);
+            throw;
+        }
+    }
+
+
+} //namespace netlib
+
+
+#endif //defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
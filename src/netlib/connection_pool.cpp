@@ -0,0 +1,259 @@
+#include "platform.hpp"
+#include <stdexcept>
+#include <system_error>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "netlib/connection_pool.hpp"
+
+
+namespace netlib {
+
+
+    //state of the pool
+    class connection_pool::state {
+    public:
+        //idle connection
+        struct idle_connection {
+            std::unique_ptr<netlib::socket> connection;
+            std::chrono::steady_clock::time_point time;
+        };
+
+        //connections of a key
+        struct key_state {
+            //idle connections, from the least to the most recently used
+            std::vector<idle_connection> idle;
+
+            //number of connections, idle or in use
+            size_t total = 0;
+        };
+
+        //hash of keys
+        struct key_hash {
+            size_t operator ()(const key& k) const {
+                return k.address.hash() ^ std::hash<void*>()(k.context.get()) ^ std::hash<std::string>()(k.server_name);
+            }
+        };
+
+        const connection_pool_options options;
+        std::mutex mutex;
+        std::condition_variable slot_available;
+        std::unordered_map<key, key_state, key_hash> keys;
+        std::unordered_set<const socket*> discarded;
+        size_t idle_count = 0;
+        size_t connection_count = 0;
+
+        state(const connection_pool_options& options) : options(options) {
+        }
+
+        //moves the idle connections that exceeded the idle timeout to the given vector
+        void evict_idle(key_state& ks, std::vector<std::unique_ptr<socket>>& closed) {
+            const auto limit = std::chrono::steady_clock::now() - options.idle_timeout;
+            auto end = std::find_if(ks.idle.begin(), ks.idle.end(), [&](const idle_connection& c) { return c.time > limit; });
+            for (auto it = ks.idle.begin(); it != end; ++it) {
+                closed.push_back(std::move(it->connection));
+            }
+            const size_t count = static_cast<size_t>(end - ks.idle.begin());
+            ks.idle.erase(ks.idle.begin(), end);
+            ks.total -= count;
+            idle_count -= count;
+            connection_count -= count;
+            if (count > 0) {
+                slot_available.notify_all();
+            }
+        }
+
+        //removes a connection of the given key from the counts
+        void remove_connection(const key& k) {
+            auto it = keys.find(k);
+            if (it != keys.end()) {
+                --it->second.total;
+                --connection_count;
+                if (it->second.total == 0) {
+                    keys.erase(it);
+                }
+            }
+            slot_available.notify_all();
+        }
+    };
+
+
+    //Constructor.
+    connection_pool::connection_pool(const connection_pool_options& options) {
+        if (options.max_total == 0) {
+            throw std::invalid_argument("Invalid max number of connections.");
+        }
+        m_state = std::make_shared<state>(options);
+    }
+
+
+    //Closes the idle connections.
+    connection_pool::~connection_pool() {
+    }
+
+
+    //Returns the options of the pool.
+    const connection_pool_options& connection_pool::options() const {
+        return m_state->options;
+    }
+
+
+    //Returns the number of idle connections.
+    size_t connection_pool::idle_count() const {
+        std::lock_guard lock(m_state->mutex);
+        return m_state->idle_count;
+    }
+
+
+    //Returns the number of connections.
+    size_t connection_pool::connection_count() const {
+        std::lock_guard lock(m_state->mutex);
+        return m_state->connection_count;
+    }
+
+
+    //Closes the idle connections that exceeded the idle timeout.
+    void connection_pool::evict_idle() {
+        //closed after unlocking, since closing may block
+        std::vector<std::unique_ptr<socket>> closed;
+
+        std::lock_guard lock(m_state->mutex);
+        for (auto it = m_state->keys.begin(); it != m_state->keys.end();) {
+            m_state->evict_idle(it->second, closed);
+            if (it->second.total == 0) {
+                it = m_state->keys.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+
+    //Marks a connection as not reusable.
+    void connection_pool::discard(const std::shared_ptr<socket>& s) {
+        if (s) {
+            std::lock_guard lock(m_state->mutex);
+            m_state->discarded.insert(s.get());
+        }
+    }
+
+
+    //Takes a healthy idle connection, or reserves a slot for a new connection.
+    std::unique_ptr<socket> connection_pool::checkout(const key& k, std::chrono::steady_clock::time_point deadline) {
+        for (;;) {
+            //closed after unlocking, since closing may block
+            std::vector<std::unique_ptr<socket>> closed;
+            std::unique_ptr<socket> s;
+
+            {
+                std::unique_lock lock(m_state->mutex);
+
+                for (;;) {
+                    state::key_state& ks = m_state->keys[k];
+                    m_state->evict_idle(ks, closed);
+
+                    //take the most recently used idle connection
+                    if (!ks.idle.empty()) {
+                        s = std::move(ks.idle.back().connection);
+                        ks.idle.pop_back();
+                        --m_state->idle_count;
+                        break;
+                    }
+
+                    //reserve a slot for a new connection
+                    if (ks.total < m_state->options.max_total) {
+                        ++ks.total;
+                        ++m_state->connection_count;
+                        return nullptr;
+                    }
+
+                    //wait for a connection to be returned or closed
+                    if (m_state->slot_available.wait_until(lock, deadline) == std::cv_status::timeout) {
+                        throw std::system_error(get_connection_timeout_error_number(), std::system_category());
+                    }
+                }
+            }
+
+            //the health check is done without the lock, since it may do i/o;
+            //if it fails, the connection is closed, and its slot is released
+            bool healthy;
+            try {
+                healthy = is_healthy(*s);
+            }
+            catch (...) {
+                std::lock_guard lock(m_state->mutex);
+                m_state->remove_connection(k);
+                throw;
+            }
+            if (healthy) {
+                return s;
+            }
+
+            //close the broken connection, then try the next one
+            std::lock_guard lock(m_state->mutex);
+            m_state->remove_connection(k);
+            closed.push_back(std::move(s));
+        }
+    }
+
+
+    //Releases a slot reserved by checkout().
+    void connection_pool::cancel(const key& k) {
+        std::lock_guard lock(m_state->mutex);
+        m_state->remove_connection(k);
+    }
+
+
+    //Checks if an idle connection can be reused.
+    bool connection_pool::is_healthy(socket& s) const {
+        if (s.buffered_receive_size() > 0) {
+            return false;
+        }
+        pollfd pfd{};
+        pfd.fd = s.handle();
+        pfd.events = POLLIN;
+        return poll(&pfd, 1, 0) == 0;
+    }
+
+
+    //Returns the time remaining until the deadline.
+    std::chrono::milliseconds connection_pool::get_remaining_time(std::chrono::steady_clock::time_point deadline) {
+        const auto duration = deadline - std::chrono::steady_clock::now();
+        return duration > std::chrono::steady_clock::duration::zero() ? std::chrono::ceil<std::chrono::milliseconds>(duration) : std::chrono::milliseconds(0);
+    }
+
+
+    //Returns a connection to the pool, or closes it if the pool is gone.
+    void connection_pool::release(const std::weak_ptr<state>& st, const key& k, std::unique_ptr<socket>&& s) {
+        const std::shared_ptr<state> pool_state = st.lock();
+        if (!pool_state) {
+            return;
+        }
+
+        //closed after unlocking, since closing may block
+        std::unique_ptr<socket> closed;
+
+        std::lock_guard lock(pool_state->mutex);
+
+        auto it = pool_state->keys.find(k);
+        const bool discarded = pool_state->discarded.erase(s.get()) > 0;
+
+        //close discarded connections, and connections beyond the idle limit
+        if (it == pool_state->keys.end() || discarded || it->second.idle.size() >= pool_state->options.max_idle) {
+            pool_state->remove_connection(k);
+            closed = std::move(s);
+            return;
+        }
+
+        //keep the connection
+        it->second.idle.push_back(state::idle_connection{ std::move(s), std::chrono::steady_clock::now() });
+        ++pool_state->idle_count;
+        pool_state->slot_available.notify_all();
+    }
+
+
+} //namespace netlib
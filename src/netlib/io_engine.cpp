@@ -0,0 +1,695 @@
+#include "platform.hpp"
+#include <stdexcept>
+#include <system_error>
+#include <chrono>
+#include <algorithm>
+#include "netlib/io_engine.hpp"
+#include "netlib/numeric_cast.hpp"
+#if NETLIB_IO_ENGINE_IO_URING
+#include <csignal>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#endif
+
+
+namespace netlib {
+
+
+    //operation
+    struct io_engine::operation {
+        operation_type type;
+        socket_ptr socket;
+        const char* data;
+        char* buffer;
+        size_t size;
+        socket_address address;
+        socklen_t address_length;
+        int error_number;
+        completion_callback_type callback;
+        #if NETLIB_IO_ENGINE_IO_URING
+        iovec io_vector{};
+        msghdr message{};
+        #endif
+
+        //returns the socket poller event that the operation waits for
+        socket_poller::event_type event() const {
+            switch (type) {
+            case operation_type::send:
+            case operation_type::send_to:
+            case operation_type::connect:
+                return socket_poller::event_type::write;
+            default:
+                return socket_poller::event_type::read;
+            }
+        }
+
+        //executes the operation, after the socket poller reports the socket as ready, without blocking;
+        //a send transfers as much as the socket can take, and completes with the partial count;
+        //returns the operation result, or the negated error number
+        intptr_t execute() {
+            intptr_t result = -1;
+            const socket::handle_type handle = socket->handle();
+
+            switch (type) {
+            case operation_type::send:
+                result = ::send(handle, data, numeric_cast<int>(size), MSG_NOSIGNAL | MSG_DONTWAIT);
+                break;
+
+            case operation_type::receive:
+                result = recv(handle, buffer, numeric_cast<int>(size), MSG_DONTWAIT);
+                break;
+
+            case operation_type::send_to:
+                result = ::sendto(handle, data, numeric_cast<int>(size), MSG_NOSIGNAL | MSG_DONTWAIT, reinterpret_cast<const sockaddr*>(address.data()), sizeof(sockaddr_storage));
+                break;
+
+            case operation_type::receive_from:
+                address_length = sizeof(sockaddr_storage);
+                result = recvfrom(handle, buffer, numeric_cast<int>(size), MSG_DONTWAIT, reinterpret_cast<sockaddr*>(address.data()), &address_length);
+                break;
+
+            case operation_type::accept: {
+                address_length = sizeof(sockaddr_storage);
+                const socket::handle_type client_handle = ::accept(handle, reinterpret_cast<sockaddr*>(address.data()), &address_length);
+                result = client_handle == socket::invalid_handle ? -1 : static_cast<intptr_t>(client_handle);
+                break;
+            }
+
+            //the socket is connected in non-blocking mode; get the result of the connection
+            case operation_type::connect: {
+                if (error_number) {
+                    return -error_number;
+                }
+                int error = 0;
+                socklen_t error_length = sizeof(error);
+                if (getsockopt(handle, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &error_length)) {
+                    return -get_last_error_number();
+                }
+                if (error) {
+                    return -error;
+                }
+                if (set_socket_non_blocking(handle, false)) {
+                    return -get_last_error_number();
+                }
+                return 0;
+            }
+            }
+
+            return result >= 0 ? result : -get_last_error_number();
+        }
+
+        //invokes the callback with the result of the operation
+        void complete(io_engine& engine, intptr_t result) {
+            completion c{ type, socket, 0, 0, address, nullptr };
+
+            //error
+            if (result < 0) {
+                c.error_number = static_cast<int>(-result);
+            }
+
+            //success
+            else {
+                switch (type) {
+                case operation_type::accept:
+                    c.client_socket = std::make_shared<unencrypted::tcp::client_socket>(static_cast<socket::handle_type>(result));
+                    break;
+
+                case operation_type::connect:
+                    c.client_socket = std::static_pointer_cast<unencrypted::tcp::client_socket>(socket);
+                    break;
+
+                default:
+                    c.bytes = static_cast<size_t>(result);
+                    break;
+                }
+            }
+
+            callback(engine, c);
+        }
+    };
+
+
+    #if NETLIB_IO_ENGINE_IO_URING
+
+
+    //io_uring system calls; liburing is not required
+    static int io_uring_setup(unsigned entries, io_uring_params* params) {
+        return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+    }
+
+
+    static int io_uring_enter(int handle, unsigned to_submit, unsigned min_complete, unsigned flags, const void* arg, size_t arg_size) {
+        return static_cast<int>(syscall(__NR_io_uring_enter, handle, to_submit, min_complete, flags, arg, arg_size));
+    }
+
+
+    //id of the wakeup operation; operation ids start from 1
+    static constexpr uint64_t wakeup_operation_id = 0;
+
+
+    //io_uring instance
+    struct io_engine::ring {
+        int handle{ -1 };
+        unsigned entries{};
+        void* rings{ MAP_FAILED };
+        size_t rings_size{};
+        io_uring_sqe* sqes{ static_cast<io_uring_sqe*>(MAP_FAILED) };
+        size_t sqes_size{};
+        unsigned* sq_head{};
+        unsigned* sq_tail{};
+        unsigned* sq_mask{};
+        unsigned* sq_array{};
+        unsigned* cq_head{};
+        unsigned* cq_tail{};
+        unsigned* cq_mask{};
+        io_uring_cqe* cqes{};
+        unsigned unsubmitted{};
+        int wakeup_handle{ -1 };
+        uint64_t wakeup_value{};
+
+        ~ring() {
+            if (wakeup_handle >= 0) {
+                ::close(wakeup_handle);
+            }
+            if (sqes != MAP_FAILED) {
+                munmap(sqes, sqes_size);
+            }
+            if (rings != MAP_FAILED) {
+                munmap(rings, rings_size);
+            }
+            if (handle >= 0) {
+                ::close(handle);
+            }
+        }
+
+        //creates the io_uring instance; returns null if io_uring is not available
+        static std::unique_ptr<ring> create(size_t entries) {
+            //setup the io_uring instance; it fails if the kernel does not support it, or if it is disabled
+            io_uring_params params{};
+            const int handle = io_uring_setup(numeric_cast<unsigned>(entries), &params);
+            if (handle < 0) {
+                return nullptr;
+            }
+
+            std::unique_ptr<ring> r = std::make_unique<ring>();
+            r->handle = handle;
+            r->entries = params.sq_entries;
+
+            //the submission and completion rings must be mapped together, and waiting with a timeout must be supported
+            if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_EXT_ARG)) {
+                return nullptr;
+            }
+
+            //map the rings
+            r->rings_size = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned), params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+            r->rings = mmap(nullptr, r->rings_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, handle, IORING_OFF_SQ_RING);
+            if (r->rings == MAP_FAILED) {
+                throw std::system_error(get_last_error_number(), std::system_category());
+            }
+
+            //map the submission queue entries
+            r->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+            r->sqes = static_cast<io_uring_sqe*>(mmap(nullptr, r->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, handle, IORING_OFF_SQES));
+            if (r->sqes == MAP_FAILED) {
+                throw std::system_error(get_last_error_number(), std::system_category());
+            }
+
+            //setup the ring pointers
+            char* const rings = static_cast<char*>(r->rings);
+            r->sq_head = reinterpret_cast<unsigned*>(rings + params.sq_off.head);
+            r->sq_tail = reinterpret_cast<unsigned*>(rings + params.sq_off.tail);
+            r->sq_mask = reinterpret_cast<unsigned*>(rings + params.sq_off.ring_mask);
+            r->sq_array = reinterpret_cast<unsigned*>(rings + params.sq_off.array);
+            r->cq_head = reinterpret_cast<unsigned*>(rings + params.cq_off.head);
+            r->cq_tail = reinterpret_cast<unsigned*>(rings + params.cq_off.tail);
+            r->cq_mask = reinterpret_cast<unsigned*>(rings + params.cq_off.ring_mask);
+            r->cqes = reinterpret_cast<io_uring_cqe*>(rings + params.cq_off.cqes);
+
+            //create the handle used for waking up the polling thread
+            r->wakeup_handle = eventfd(0, EFD_CLOEXEC);
+            if (r->wakeup_handle < 0) {
+                throw std::system_error(get_last_error_number(), std::system_category());
+            }
+
+            return r;
+        }
+
+        //returns the next submission queue entry; if the queue is full, the queued entries are submitted first
+        io_uring_sqe* get_sqe() {
+            if (*sq_tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE) >= entries) {
+                enter(0, -1);
+            }
+            const unsigned index = *sq_tail & *sq_mask;
+            io_uring_sqe* sqe = &sqes[index];
+            memset(sqe, 0, sizeof(*sqe));
+            sq_array[index] = index;
+            return sqe;
+        }
+
+        //makes the entry returned by get_sqe() visible to the kernel
+        void commit_sqe() {
+            __atomic_store_n(sq_tail, *sq_tail + 1, __ATOMIC_RELEASE);
+            ++unsubmitted;
+        }
+
+        //submits the queued entries, and optionally waits for completions;
+        //returns the number of submitted entries, or -1 on error
+        int enter(unsigned min_complete, int timeout_ms) {
+            __kernel_timespec ts{};
+            io_uring_getevents_arg arg{};
+            arg.sigmask_sz = _NSIG / 8;
+            if (timeout_ms >= 0) {
+                ts.tv_sec = timeout_ms / 1000;
+                ts.tv_nsec = (timeout_ms % 1000) * 1000000ll;
+                arg.ts = reinterpret_cast<uint64_t>(&ts);
+            }
+
+            const int result = io_uring_enter(handle, unsubmitted, min_complete, (min_complete ? IORING_ENTER_GETEVENTS : 0) | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+
+            if (result > 0) {
+                unsubmitted -= static_cast<unsigned>(result);
+            }
+
+            return result;
+        }
+    };
+
+
+    #else
+
+
+    //io_uring instance; not available
+    struct io_engine::ring {
+        static std::unique_ptr<ring> create(size_t entries) {
+            return nullptr;
+        }
+    };
+
+
+    #endif
+
+
+    //Constructor.
+    io_engine::io_engine(size_t queue_size)
+        : m_stop{}
+        , m_ring(ring::create(queue_size))
+        #if NETLIB_IO_ENGINE_IO_URING
+        , m_next_operation_id{1}
+        , m_waiting{}
+        , m_wakeup_pending{false}
+        #endif
+    {
+        #if NETLIB_IO_ENGINE_IO_URING
+        if (m_ring) {
+            submit_wakeup();
+        }
+        #endif
+    }
+
+
+    //Stops the engine.
+    io_engine::~io_engine() {
+        stop();
+
+        //close io_uring before the submitted operations are deleted
+        m_ring.reset();
+    }
+
+
+    //Queues a send operation.
+    void io_engine::send(const std::shared_ptr<unencrypted::tcp::client_socket>& s, const char* data, size_t size, const completion_callback_type& cb) {
+        if (!s) {
+            throw std::invalid_argument("Invalid socket.");
+        }
+        if (!cb) {
+            throw std::invalid_argument("Empty completion callback.");
+        }
+        queue(std::unique_ptr<operation>(new operation{ operation_type::send, s, data, nullptr, size, {}, 0, 0, cb }));
+    }
+
+
+    //Queues a receive operation.
+    void io_engine::receive(const std::shared_ptr<unencrypted::tcp::client_socket>& s, char* buffer, size_t size, const completion_callback_type& cb) {
+        if (!s) {
+            throw std::invalid_argument("Invalid socket.");
+        }
+        if (!cb) {
+            throw std::invalid_argument("Empty completion callback.");
+        }
+        queue(std::unique_ptr<operation>(new operation{ operation_type::receive, s, nullptr, buffer, size, {}, 0, 0, cb }));
+    }
+
+
+    //Queues a datagram send operation.
+    void io_engine::send_to(const std::shared_ptr<unencrypted::udp::socket>& s, const char* data, size_t size, const socket_address& receiver_addr, const completion_callback_type& cb) {
+        if (!s) {
+            throw std::invalid_argument("Invalid socket.");
+        }
+        if (!cb) {
+            throw std::invalid_argument("Empty completion callback.");
+        }
+        queue(std::unique_ptr<operation>(new operation{ operation_type::send_to, s, data, nullptr, size, receiver_addr, 0, 0, cb }));
+    }
+
+
+    //Queues a datagram receive operation.
+    void io_engine::receive_from(const std::shared_ptr<unencrypted::udp::socket>& s, char* buffer, size_t size, const completion_callback_type& cb) {
+        if (!s) {
+            throw std::invalid_argument("Invalid socket.");
+        }
+        if (!cb) {
+            throw std::invalid_argument("Empty completion callback.");
+        }
+        queue(std::unique_ptr<operation>(new operation{ operation_type::receive_from, s, nullptr, buffer, size, {}, 0, 0, cb }));
+    }
+
+
+    //Queues an accept operation.
+    void io_engine::accept(const std::shared_ptr<unencrypted::tcp::server_socket>& s, const completion_callback_type& cb) {
+        if (!s) {
+            throw std::invalid_argument("Invalid socket.");
+        }
+        if (!cb) {
+            throw std::invalid_argument("Empty completion callback.");
+        }
+        queue(std::unique_ptr<operation>(new operation{ operation_type::accept, s, nullptr, nullptr, 0, {}, 0, 0, cb }));
+    }
+
+
+    //Queues a connect operation.
+    void io_engine::connect(const socket_address& server_addr, const completion_callback_type& cb) {
+        if (!cb) {
+            throw std::invalid_argument("Empty completion callback.");
+        }
+
+        //create the socket
+        const socket::handle_type handle = ::socket(server_addr.address_family(), SOCK_STREAM, IPPROTO_TCP);
+        if (handle == socket::invalid_handle) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+        auto s = std::make_shared<unencrypted::tcp::client_socket>(handle);
+        std::unique_ptr<operation> op(new operation{ operation_type::connect, s, nullptr, nullptr, 0, server_addr, 0, 0, cb });
+
+        //without io_uring, connect in non-blocking mode, then wait for the socket to become writable;
+        //an immediate error is reported when the socket poller reports the socket
+        if (!m_ring) {
+            if (set_socket_non_blocking(s->handle(), true)) {
+                throw std::system_error(get_last_error_number(), std::system_category());
+            }
+            if (::connect(s->handle(), reinterpret_cast<const sockaddr*>(server_addr.data()), sizeof(sockaddr_storage))) {
+                const int error = get_last_error_number();
+                if (!is_operation_in_progress_error(error)) {
+                    op->error_number = error;
+                }
+            }
+        }
+
+        queue(std::move(op));
+    }
+
+
+    //Submits the queued operations, waits for completions, then invokes the completion callbacks.
+    io_engine::poll_status io_engine::poll(int timeout_ms) {
+        #if NETLIB_IO_ENGINE_IO_URING
+        if (m_ring) {
+            return ring_poll(timeout_ms);
+        }
+        #endif
+        return m_poller.poll(timeout_ms);
+    }
+
+
+    //Stops the engine, if not stopped yet.
+    void io_engine::stop() {
+        {
+            std::lock_guard lock(m_mutex);
+
+            if (m_stop) {
+                return;
+            }
+
+            m_stop = true;
+        }
+
+        #if NETLIB_IO_ENGINE_IO_URING
+        if (m_ring) {
+            const uint64_t value = 1;
+            ::write(m_ring->wakeup_handle, &value, sizeof(value));
+        }
+        #endif
+
+        m_poller.stop();
+    }
+
+
+    //queues an operation
+    void io_engine::queue(std::unique_ptr<operation>&& op) {
+        #if NETLIB_IO_ENGINE_IO_URING
+        //with io_uring, the operation is submitted by the polling thread;
+        //the polling thread is woken up only if it is waiting for completions
+        if (m_ring) {
+            bool wakeup;
+            {
+                std::lock_guard lock(m_mutex);
+                m_pending_operations.push_back(std::move(op));
+                wakeup = m_waiting && !m_wakeup_pending.exchange(true);
+            }
+            if (wakeup) {
+                const uint64_t value = 1;
+                ::write(m_ring->wakeup_handle, &value, sizeof(value));
+            }
+            return;
+        }
+        #endif
+
+        //without io_uring, the operation waits for the socket poller to report the socket as ready;
+        //operations on the same socket and event are executed in the order they were queued
+        const socket_poller::event_type event = op->event();
+        const socket_ptr s = op->socket;
+        std::lock_guard lock(m_mutex);
+        auto it = m_poller_operations.try_emplace(s->handle()).first;
+        auto& operations = it->second[static_cast<size_t>(event)];
+        operations.push_back(std::move(op));
+        if (operations.size() == 1 && !m_poller.add(s, event, [this](socket_poller&, const socket_ptr& s, socket_poller::event_type e, socket_poller::status_flags) {
+            on_socket_ready(s, e);
+            }))
+        {
+            //only the operation just queued is dropped; the operations queued for the other event are kept
+            operations.pop_back();
+            if (it->second[0].empty() && it->second[1].empty()) {
+                m_poller_operations.erase(it);
+            }
+            throw std::runtime_error("Socket poller is full.");
+        }
+    }
+
+
+    #if NETLIB_IO_ENGINE_IO_URING
+
+
+    //submits an operation to io_uring
+    void io_engine::submit(std::unique_ptr<operation>&& op) {
+        const uint64_t id = m_next_operation_id++;
+
+        io_uring_sqe* sqe = m_ring->get_sqe();
+        sqe->fd = static_cast<int>(op->socket->handle());
+        sqe->user_data = id;
+
+        switch (op->type) {
+        case operation_type::send:
+            sqe->opcode = IORING_OP_SEND;
+            sqe->addr = reinterpret_cast<uint64_t>(op->data);
+            sqe->len = numeric_cast<uint32_t>(op->size);
+            sqe->msg_flags = MSG_NOSIGNAL;
+            break;
+
+        case operation_type::receive:
+            sqe->opcode = IORING_OP_RECV;
+            sqe->addr = reinterpret_cast<uint64_t>(op->buffer);
+            sqe->len = numeric_cast<uint32_t>(op->size);
+            break;
+
+        case operation_type::send_to:
+        case operation_type::receive_from:
+            op->io_vector.iov_base = op->type == operation_type::send_to ? const_cast<char*>(op->data) : op->buffer;
+            op->io_vector.iov_len = op->size;
+            op->message = msghdr{};
+            op->message.msg_name = op->address.data();
+            op->message.msg_namelen = sizeof(sockaddr_storage);
+            op->message.msg_iov = &op->io_vector;
+            op->message.msg_iovlen = 1;
+            sqe->opcode = op->type == operation_type::send_to ? IORING_OP_SENDMSG : IORING_OP_RECVMSG;
+            sqe->addr = reinterpret_cast<uint64_t>(&op->message);
+            sqe->len = 1;
+            break;
+
+        case operation_type::accept:
+            op->address_length = sizeof(sockaddr_storage);
+            sqe->opcode = IORING_OP_ACCEPT;
+            sqe->addr = reinterpret_cast<uint64_t>(op->address.data());
+            sqe->off = reinterpret_cast<uint64_t>(&op->address_length);
+            break;
+
+        case operation_type::connect:
+            sqe->opcode = IORING_OP_CONNECT;
+            sqe->addr = reinterpret_cast<uint64_t>(op->address.data());
+            sqe->off = sizeof(sockaddr_storage);
+            break;
+        }
+
+        m_ring->commit_sqe();
+        m_operations.emplace(id, std::move(op));
+    }
+
+
+    //submits the read of the wakeup handle to io_uring
+    void io_engine::submit_wakeup() {
+        io_uring_sqe* sqe = m_ring->get_sqe();
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = m_ring->wakeup_handle;
+        sqe->addr = reinterpret_cast<uint64_t>(&m_ring->wakeup_value);
+        sqe->len = sizeof(m_ring->wakeup_value);
+        sqe->user_data = wakeup_operation_id;
+        m_ring->commit_sqe();
+    }
+
+
+    //processes the io_uring completions
+    size_t io_engine::process_completions() {
+        size_t count = 0;
+
+        for (unsigned head = *m_ring->cq_head; head != __atomic_load_n(m_ring->cq_tail, __ATOMIC_ACQUIRE); ) {
+            //copy the completion, then free its slot, before invoking the callback
+            const io_uring_cqe cqe = m_ring->cqes[head & *m_ring->cq_mask];
+            __atomic_store_n(m_ring->cq_head, ++head, __ATOMIC_RELEASE);
+
+            //the wakeup handle was read; read it again
+            if (cqe.user_data == wakeup_operation_id) {
+                m_wakeup_pending = false;
+                submit_wakeup();
+                continue;
+            }
+
+            //find the operation
+            auto it = m_operations.find(cqe.user_data);
+            if (it == m_operations.end()) {
+                continue;
+            }
+            std::unique_ptr<operation> op = std::move(it->second);
+            m_operations.erase(it);
+
+            //invoke the callback
+            op->complete(*this, cqe.res);
+            ++count;
+        }
+
+        return count;
+    }
+
+
+    //io_uring poll
+    io_engine::poll_status io_engine::ring_poll(int timeout_ms) {
+        const auto end_time = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max(timeout_ms, 0));
+
+        for (;;) {
+            //get the queued operations
+            std::vector<std::unique_ptr<operation>> operations;
+            {
+                std::lock_guard lock(m_mutex);
+
+                //if stopped
+                if (m_stop) {
+                    return poll_status::stopped;
+                }
+
+                operations.swap(m_pending_operations);
+                m_waiting = true;
+            }
+
+            //submit the queued operations and wait for completions, with one system call
+            for (std::unique_ptr<operation>& op : operations) {
+                submit(std::move(op));
+            }
+            int wait_ms = timeout_ms;
+            if (timeout_ms > 0) {
+                const auto remaining_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - std::chrono::steady_clock::now());
+                wait_ms = static_cast<int>(std::max<std::chrono::milliseconds::rep>(remaining_time.count(), 0));
+            }
+            const int result = m_ring->enter(1, wait_ms);
+            const int error = result < 0 ? get_last_error_number() : 0;
+
+            {
+                std::lock_guard lock(m_mutex);
+                m_waiting = false;
+            }
+
+            //timeout, interruption by a signal, and a full completion queue are not errors
+            if (result < 0 && error != ETIME && error != EINTR && error != EBUSY && error != EAGAIN) {
+                throw std::system_error(error, std::system_category());
+            }
+
+            //invoke the callbacks
+            if (process_completions() > 0) {
+                return poll_status::success;
+            }
+
+            //timeout
+            if (timeout_ms >= 0 && std::chrono::steady_clock::now() >= end_time) {
+                return poll_status::timeout;
+            }
+        }
+    }
+
+
+    #endif
+
+
+    //invoked when the socket poller reports a socket as ready
+    void io_engine::on_socket_ready(const socket_ptr& s, socket_poller::event_type e) {
+        operation* next;
+
+        //get the next operation of the socket and event; it stays queued while it executes,
+        //so as that operations queued meanwhile do not register the socket again
+        {
+            std::lock_guard lock(m_mutex);
+            auto it = m_poller_operations.find(s->handle());
+            if (it == m_poller_operations.end()) {
+                return;
+            }
+            auto& operations = it->second[static_cast<size_t>(e)];
+            if (operations.empty()) {
+                return;
+            }
+            next = operations.front().get();
+        }
+
+        //execute the operation; if the socket was not ready after all, the operation waits for it again
+        const intptr_t result = next->execute();
+        if (result < 0 && is_operation_in_progress_error(static_cast<int>(-result))) {
+            return;
+        }
+
+        //remove the operation; stop waiting for the event if there are no more operations for it
+        std::unique_ptr<operation> op;
+        {
+            std::lock_guard lock(m_mutex);
+            auto it = m_poller_operations.find(s->handle());
+            auto& operations = it->second[static_cast<size_t>(e)];
+            op = std::move(operations.front());
+            operations.pop_front();
+            if (operations.empty()) {
+                m_poller.remove(s, e);
+                if (it->second[0].empty() && it->second[1].empty()) {
+                    m_poller_operations.erase(it);
+                }
+            }
+        }
+
+        //invoke the callback
+        op->complete(*this, result);
+    }
+
+
+} //namespace netlib
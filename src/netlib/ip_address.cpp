@@ -1,6 +1,7 @@
 #include "platform.hpp"
 #include <stdexcept>
 #include <system_error>
+#include <algorithm>
 #include "netlib/ip_address.hpp"
 #include "hash.hpp"
 
@@ -188,6 +189,82 @@ namespace netlib {
     }
 
 
+    //Resolves a hostname/ip address string to all of its ip addresses.
+    std::vector<ip_address> ip_address::resolve(const char* hostname, int type) {
+        char localhost_name[HOST_NAME_MAX + 1];
+
+        //check type
+        switch (type) {
+        case 0:
+        case AF_INET:
+        case AF_INET6:
+            break;
+        default:
+            throw std::invalid_argument("Invalid address family.");
+        }
+
+        //ip address strings are converted by the constructor, which also handles the zone index of ip6 addresses
+        if (hostname && strlen(hostname) > 0) {
+            char buffer[16];
+            const char* zone_index_str = strchr(hostname, '%');
+            const std::string ip6_str = zone_index_str ? std::string(hostname, zone_index_str) : std::string(hostname);
+            if ((type != AF_INET6 && inet_pton(AF_INET, hostname, buffer) == 1) || (type != AF_INET && inet_pton(AF_INET6, ip6_str.c_str(), buffer) == 1)) {
+                return { ip_address(hostname, type) };
+            }
+        }
+
+        //else if hostname is not given, find the name of the localhost
+        else {
+            localhost_name[HOST_NAME_MAX] = '\0';
+            if (gethostname(localhost_name, sizeof(localhost_name))) {
+                throw std::system_error(get_last_error_number(), std::system_category());
+            }
+            hostname = localhost_name;
+        }
+
+        //get address info; one socket type, so as that each address is returned once
+        addrinfo hints{};
+        hints.ai_family = type ? type : AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* ai;
+        int error = getaddrinfo(hostname, nullptr, &hints, &ai);
+        if (error) {
+            throw std::system_error(error, std::system_category());
+        }
+
+        //collect the addresses
+        std::vector<ip_address> result;
+        for (addrinfo* tai = ai; tai; tai = tai->ai_next) {
+            ip_address addr;
+            switch (tai->ai_family) {
+            case AF_INET:
+                addr = ip_address(reinterpret_cast<const std::array<char, 4>&>(reinterpret_cast<sockaddr_in*>(tai->ai_addr)->sin_addr));
+                break;
+
+            case AF_INET6:
+                addr = ip_address(reinterpret_cast<const std::array<char, 16>&>(reinterpret_cast<sockaddr_in6*>(tai->ai_addr)->sin6_addr), reinterpret_cast<sockaddr_in6*>(tai->ai_addr)->sin6_scope_id);
+                break;
+
+            default:
+                continue;
+            }
+            if (std::find(result.begin(), result.end(), addr) == result.end()) {
+                result.push_back(addr);
+            }
+        }
+
+        //free the memory allocated from getaddrinfo
+        freeaddrinfo(ai);
+
+        //if address not found
+        if (result.empty()) {
+            throw std::logic_error("IP4/IP6 address not found for hostname = " + std::string(hostname));
+        }
+
+        return result;
+    }
+
+
     /**
      * Returns the ip4 value.
      */
@@ -201,7 +278,7 @@ namespace netlib {
         std::array<uint16_t, 8> r;
 
         for (size_t i = 0; i < 8; ++i) {
-            r[i] = ntohs(reinterpret_cast<const std::array<uint16_t, 8>&>(m_data)[i]);
+            r[i] = ntohs((reinterpret_cast<const std::array<uint16_t, 8>&>(m_data)[i]));
         }
 
         return r;
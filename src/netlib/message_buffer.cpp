@@ -0,0 +1,199 @@
+#include <new>
+#include <mutex>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include "netlib/message_buffer.hpp"
+
+
+namespace netlib {
+
+
+    static_assert(NETLIB_MESSAGE_BUFFER_MIN_CAPACITY > 0 && (NETLIB_MESSAGE_BUFFER_MIN_CAPACITY & (NETLIB_MESSAGE_BUFFER_MIN_CAPACITY - 1)) == 0, "NETLIB_MESSAGE_BUFFER_MIN_CAPACITY must be a power of 2.");
+    static_assert((NETLIB_MESSAGE_BUFFER_MAX_CAPACITY & (NETLIB_MESSAGE_BUFFER_MAX_CAPACITY - 1)) == 0 && NETLIB_MESSAGE_BUFFER_MAX_CAPACITY >= NETLIB_MESSAGE_BUFFER_MIN_CAPACITY, "NETLIB_MESSAGE_BUFFER_MAX_CAPACITY must be a power of 2, not less than NETLIB_MESSAGE_BUFFER_MIN_CAPACITY.");
+    static_assert(NETLIB_MESSAGE_BUFFER_THREAD_CACHE_SIZE >= 2, "NETLIB_MESSAGE_BUFFER_THREAD_CACHE_SIZE must be at least 2.");
+
+
+    //returns the number of size classes
+    static constexpr size_t get_size_class_count() {
+        size_t count = 1;
+        for (size_t capacity = NETLIB_MESSAGE_BUFFER_MIN_CAPACITY; capacity < NETLIB_MESSAGE_BUFFER_MAX_CAPACITY; capacity *= 2) {
+            ++count;
+        }
+        return count;
+    }
+
+
+    //number of size classes; buffers of this class are larger than the largest size class
+    static constexpr size_t size_class_count = get_size_class_count();
+
+
+    //number of buffers moved at once between a thread cache and the shared cache
+    static constexpr size_t transfer_count = NETLIB_MESSAGE_BUFFER_THREAD_CACHE_SIZE / 2;
+
+
+    //returns the size class of the given capacity
+    static size_t get_size_class(size_t capacity) {
+        if (capacity > NETLIB_MESSAGE_BUFFER_MAX_CAPACITY) {
+            return size_class_count;
+        }
+        size_t size_class = 0;
+        for (size_t class_capacity = NETLIB_MESSAGE_BUFFER_MIN_CAPACITY; class_capacity < capacity; class_capacity *= 2) {
+            ++size_class;
+        }
+        return size_class;
+    }
+
+
+    //returns the capacity of the given size class
+    static size_t get_size_class_capacity(size_t size_class) {
+        return static_cast<size_t>(NETLIB_MESSAGE_BUFFER_MIN_CAPACITY) << size_class;
+    }
+
+
+    //released buffers shared by all threads
+    class shared_cache {
+    public:
+        //moves up to the given number of buffers to the given vector
+        void take(size_t size_class, std::vector<void*>& buffers, size_t count) {
+            std::lock_guard lock(m_mutex);
+            std::vector<void*>& src = m_buffers[size_class];
+            const size_t n = std::min(count, src.size());
+            buffers.insert(buffers.end(), src.end() - n, src.end());
+            src.resize(src.size() - n);
+        }
+
+        //moves the given number of buffers from the end of the given vector
+        void put(size_t size_class, std::vector<void*>& buffers, size_t count) {
+            std::lock_guard lock(m_mutex);
+            m_buffers[size_class].insert(m_buffers[size_class].end(), buffers.end() - count, buffers.end());
+            buffers.resize(buffers.size() - count);
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::array<std::vector<void*>, size_class_count> m_buffers;
+    };
+
+
+    //returns the shared cache; it is never destroyed, since buffers may be released during static destruction
+    static shared_cache& get_shared_cache() {
+        static shared_cache* const cache = new shared_cache;
+        return *cache;
+    }
+
+
+    //set when the cache of the current thread is destroyed; then buffers are released to the shared cache
+    static thread_local bool thread_cache_destroyed = false;
+
+
+    //released buffers kept by a thread; accessed without locking
+    class thread_cache {
+    public:
+        thread_cache() {
+            for (std::vector<void*>& buffers : m_buffers) {
+                buffers.reserve(NETLIB_MESSAGE_BUFFER_THREAD_CACHE_SIZE);
+            }
+        }
+
+        //moves the buffers to the shared cache, for other threads to reuse
+        ~thread_cache() {
+            for (size_t size_class = 0; size_class < size_class_count; ++size_class) {
+                get_shared_cache().put(size_class, m_buffers[size_class], m_buffers[size_class].size());
+            }
+            thread_cache_destroyed = true;
+        }
+
+        void* allocate(size_t size_class, size_t block_size) {
+            std::vector<void*>& buffers = m_buffers[size_class];
+
+            //refill from the shared cache, or from a new slab
+            if (buffers.empty()) {
+                get_shared_cache().take(size_class, buffers, transfer_count);
+                if (buffers.empty()) {
+                    allocate_slab(buffers, block_size);
+                }
+            }
+
+            void* const result = buffers.back();
+            buffers.pop_back();
+            return result;
+        }
+
+        void release(size_t size_class, void* buffer) {
+            std::vector<void*>& buffers = m_buffers[size_class];
+
+            //the cache is full; move the least recently released buffers to the shared cache
+            if (buffers.size() == NETLIB_MESSAGE_BUFFER_THREAD_CACHE_SIZE) {
+                std::rotate(buffers.begin(), buffers.begin() + transfer_count, buffers.end());
+                get_shared_cache().put(size_class, buffers, transfer_count);
+            }
+
+            buffers.push_back(buffer);
+        }
+
+    private:
+        std::array<std::vector<void*>, size_class_count> m_buffers;
+
+        //allocates a slab and splits it into buffers; slabs are never freed
+        static void allocate_slab(std::vector<void*>& buffers, size_t block_size) {
+            const size_t count = std::clamp<size_t>(NETLIB_MESSAGE_BUFFER_SLAB_SIZE / block_size, 1, NETLIB_MESSAGE_BUFFER_THREAD_CACHE_SIZE);
+            char* const slab = static_cast<char*>(::operator new(count * block_size));
+            for (size_t i = count; i > 0; --i) {
+                buffers.push_back(slab + (i - 1) * block_size);
+            }
+        }
+    };
+
+
+    //returns the cache of the current thread
+    static thread_cache& get_thread_cache() {
+        static thread_local thread_cache cache;
+        return cache;
+    }
+
+
+    //Acquires a buffer with at least the given capacity.
+    message_buffer::message_buffer(size_t capacity) {
+        const size_t size_class = get_size_class(capacity);
+
+        void* memory;
+
+        //buffers of a size class come from the cache of the thread
+        if (size_class < size_class_count) {
+            capacity = get_size_class_capacity(size_class);
+            memory = get_thread_cache().allocate(size_class, sizeof(block) + capacity);
+        }
+
+        //large buffers are allocated individually
+        else {
+            memory = ::operator new(sizeof(block) + capacity);
+        }
+
+        m_block = new (memory) block{ {1}, 0, capacity, size_class };
+    }
+
+
+    //releases the memory of a buffer
+    void message_buffer::release(block* b) {
+        const size_t size_class = b->size_class;
+        b->~block();
+
+        //large buffers are freed
+        if (size_class == size_class_count) {
+            ::operator delete(b);
+            return;
+        }
+
+        //the cache of the thread is gone while the thread exits
+        if (thread_cache_destroyed) {
+            std::vector<void*> buffers{ b };
+            get_shared_cache().put(size_class, buffers, 1);
+            return;
+        }
+
+        get_thread_cache().release(size_class, b);
+    }
+
+
+} //namespace netlib
@@ -94,4 +94,100 @@ int get_socket_closed_error_number() {
 }
 
 
+int set_socket_non_blocking(uintptr_t handle, bool non_blocking) {
+    u_long mode = non_blocking ? 1 : 0;
+    return ioctlsocket(handle, FIONBIO, &mode);
+}
+
+
+bool is_operation_in_progress_error(int error) {
+    return error == WSAEWOULDBLOCK || error == WSAEINPROGRESS;
+}
+
+
+int set_socket_no_sigpipe(uintptr_t) {
+    return 0;
+}
+
+
+#endif
+
+
+#ifndef _WIN32
+
+
+#include <cerrno>
+
+
+int get_last_error_number() {
+    return errno;
+}
+
+
+std::string get_error_message(int error) {
+    if (!error) {
+        return std::string();
+    }
+    return '[' + std::to_string(error) + "] " + strerror(error);
+}
+
+
+std::string get_last_error_message() {
+    return get_error_message(get_last_error_number());
+}
+
+
+bool is_socket_closed_error(int error) {
+    switch (error) {
+    case ECONNABORTED:
+    case ECONNRESET:
+    case ENOTSOCK:
+    case EBADF:
+    case EPIPE:
+        return true;
+    }
+    return false;
+}
+
+
+int get_connection_timeout_error_number() {
+    return ETIMEDOUT;
+}
+
+
+int get_socket_closed_error_number() {
+    return EBADF;
+}
+
+
+int closesocket(uintptr_t handle) {
+    return ::close(static_cast<int>(handle));
+}
+
+
+int set_socket_non_blocking(uintptr_t handle, bool non_blocking) {
+    const int flags = fcntl(static_cast<int>(handle), F_GETFL, 0);
+    if (flags < 0) {
+        return flags;
+    }
+    return fcntl(static_cast<int>(handle), F_SETFL, non_blocking ? flags | O_NONBLOCK : flags & ~O_NONBLOCK);
+}
+
+
+bool is_operation_in_progress_error(int error) {
+    return error == EINPROGRESS || error == EAGAIN || error == EWOULDBLOCK;
+}
+
+
+int set_socket_no_sigpipe(uintptr_t handle) {
+    #ifdef SO_NOSIGPIPE
+    const int value = 1;
+    return setsockopt(static_cast<int>(handle), SOL_SOCKET, SO_NOSIGPIPE, &value, sizeof(value));
+    #else
+    static_cast<void>(handle);
+    return 0;
+    #endif
+}
+
+
 #endif
@@ -16,6 +16,44 @@ bool is_socket_closed_error(int error);
 int poll(pollfd* fda, unsigned long fds, int timeout);
 int get_connection_timeout_error_number();
 int get_socket_closed_error_number();
+int set_socket_non_blocking(uintptr_t handle, bool non_blocking);
+bool is_operation_in_progress_error(int error);
+int set_socket_no_sigpipe(uintptr_t handle);
+#define MSG_NOSIGNAL 0
+#define MSG_DONTWAIT 0
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <netinet/udp.h>
+#endif
+int get_last_error_number();
+std::string get_error_message(int error);
+std::string get_last_error_message();
+bool is_socket_closed_error(int error);
+int get_connection_timeout_error_number();
+int get_socket_closed_error_number();
+int closesocket(uintptr_t handle);
+int set_socket_non_blocking(uintptr_t handle, bool non_blocking);
+bool is_operation_in_progress_error(int error);
+int set_socket_no_sigpipe(uintptr_t handle);
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
 #endif
 
 
@@ -16,7 +16,7 @@ namespace netlib {
     //Returns the address this socket is connected to.
     socket_address socket::peer_address(handle_type socket) {
         sockaddr_storage s;
-        int namelen = sizeof(s);
+        socklen_t namelen = sizeof(s);
 
         if (getpeername(socket, reinterpret_cast<sockaddr*>(&s), &namelen)) {
             throw std::system_error(get_last_error_number(), std::system_category());
@@ -37,7 +37,7 @@ namespace netlib {
     //Returns the address this socket is bound to.
     socket_address socket::bound_address(handle_type socket) {
         sockaddr_storage s;
-        int namelen = sizeof(s);
+        socklen_t namelen = sizeof(s);
 
         if (getsockname(socket, reinterpret_cast<sockaddr*>(&s), &namelen)) {
             throw std::system_error(get_last_error_number(), std::system_category());
@@ -71,18 +71,128 @@ namespace netlib {
 
     //Sets SO_REUSEADDR and SO_REUSEPORT (if available) on the underlying socket handle.
     void socket::set_reuse_address_and_port(handle_type handle) {
-        const char on = 1;
+        const int on = 1;
 
-        if (setsockopt(handle, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) < 0) {
+        if (setsockopt(handle, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&on), sizeof(on)) < 0) {
             throw std::system_error(get_last_error_number(), std::system_category());
         }
 
         #ifdef SO_REUSEPORT
-        if (setsockopt(handle, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) < 0) {
+        if (setsockopt(handle, SOL_SOCKET, SO_REUSEPORT, reinterpret_cast<const char*>(&on), sizeof(on)) < 0) {
             throw std::system_error(get_last_error_number(), std::system_category());
         }
         #endif
     }
 
 
+    //sets an integer socket option
+    static void set_option(socket::handle_type handle, int level, int name, int value) {
+        if (setsockopt(handle, level, name, reinterpret_cast<const char*>(&value), sizeof(value)) < 0) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+    }
+
+
+    //throws the error for an option that is not available on the platform
+    [[noreturn, maybe_unused]] static void throw_option_not_supported() {
+        throw std::system_error(std::make_error_code(std::errc::no_protocol_option));
+    }
+
+
+    //Sets the given options on the given socket handle.
+    void socket::set_options(handle_type handle, const socket_options& options) {
+        if (options.no_delay) {
+            set_option(handle, IPPROTO_TCP, TCP_NODELAY, *options.no_delay);
+        }
+
+        if (options.quick_ack) {
+            #ifdef TCP_QUICKACK
+            set_option(handle, IPPROTO_TCP, TCP_QUICKACK, *options.quick_ack);
+            #else
+            throw_option_not_supported();
+            #endif
+        }
+
+        if (options.cork) {
+            #if defined(TCP_CORK)
+            set_option(handle, IPPROTO_TCP, TCP_CORK, *options.cork);
+            #elif defined(TCP_NOPUSH)
+            set_option(handle, IPPROTO_TCP, TCP_NOPUSH, *options.cork);
+            #else
+            throw_option_not_supported();
+            #endif
+        }
+
+        if (options.send_buffer_size) {
+            set_option(handle, SOL_SOCKET, SO_SNDBUF, *options.send_buffer_size);
+        }
+
+        if (options.receive_buffer_size) {
+            set_option(handle, SOL_SOCKET, SO_RCVBUF, *options.receive_buffer_size);
+        }
+
+        if (options.busy_poll) {
+            #ifdef SO_BUSY_POLL
+            set_option(handle, SOL_SOCKET, SO_BUSY_POLL, static_cast<int>(options.busy_poll->count()));
+            #else
+            throw_option_not_supported();
+            #endif
+        }
+
+        if (options.user_timeout) {
+            #ifdef TCP_USER_TIMEOUT
+            set_option(handle, IPPROTO_TCP, TCP_USER_TIMEOUT, static_cast<int>(options.user_timeout->count()));
+            #else
+            throw_option_not_supported();
+            #endif
+        }
+
+        if (options.not_sent_low_water_mark) {
+            #ifdef TCP_NOTSENT_LOWAT
+            set_option(handle, IPPROTO_TCP, TCP_NOTSENT_LOWAT, *options.not_sent_low_water_mark);
+            #else
+            throw_option_not_supported();
+            #endif
+        }
+
+        if (options.keep_alive) {
+            set_option(handle, SOL_SOCKET, SO_KEEPALIVE, *options.keep_alive);
+        }
+
+        if (options.keep_alive_idle) {
+            #if defined(TCP_KEEPIDLE)
+            set_option(handle, IPPROTO_TCP, TCP_KEEPIDLE, static_cast<int>(options.keep_alive_idle->count()));
+            #elif defined(TCP_KEEPALIVE)
+            set_option(handle, IPPROTO_TCP, TCP_KEEPALIVE, static_cast<int>(options.keep_alive_idle->count()));
+            #else
+            throw_option_not_supported();
+            #endif
+        }
+
+        if (options.keep_alive_interval) {
+            #ifdef TCP_KEEPINTVL
+            set_option(handle, IPPROTO_TCP, TCP_KEEPINTVL, static_cast<int>(options.keep_alive_interval->count()));
+            #else
+            throw_option_not_supported();
+            #endif
+        }
+
+        if (options.keep_alive_count) {
+            #ifdef TCP_KEEPCNT
+            set_option(handle, IPPROTO_TCP, TCP_KEEPCNT, *options.keep_alive_count);
+            #else
+            throw_option_not_supported();
+            #endif
+        }
+
+        if (options.priority) {
+            #ifdef SO_PRIORITY
+            set_option(handle, SOL_SOCKET, SO_PRIORITY, *options.priority);
+            #else
+            throw_option_not_supported();
+            #endif
+        }
+    }
+
+
 } //namespace netlib
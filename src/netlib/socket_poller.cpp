@@ -33,8 +33,12 @@ namespace netlib {
     };
 
 
-    //creates the com socket
-    static socket::handle_type create_com_socket() {
+    #ifdef _WIN32
+
+
+    //creates the com handles; on Windows, only sockets can be polled, 
+    //so a loopback udp socket connected to itself is used for both reading and writing
+    static std::array<socket::handle_type, 2> create_com_handles() {
         //create socket
         socket::handle_type s = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
         
@@ -58,30 +62,223 @@ namespace netlib {
         }
 
         //success
-        return s;
+        return { s, s };
+    }
+
+
+    //closes the com handles
+    static void close_com_handles(const socket::handle_type* handles) {
+        closesocket(handles[0]);
+    }
+
+
+    //sends a signal to the com handles
+    static void send_com_signal(socket::handle_type handle) {
+        char buf = 0;
+        ::send(handle, &buf, sizeof(buf), 0);
+    }
+
+
+    //receives a signal from the com handles; blocks if there is no signal
+    static int receive_com_signal(socket::handle_type handle) {
+        char buf;
+        return recv(handle, &buf, sizeof(buf), 0);
+    }
+
+
+    #elif defined(__linux__)
+
+
+    //creates the com handles; on Linux, an eventfd is used for both reading and writing,
+    //which does not involve the network stack, and which coalesces pending signals into one
+    static std::array<socket::handle_type, 2> create_com_handles() {
+        //create the eventfd
+        const int fd = eventfd(0, EFD_CLOEXEC);
+
+        //handle error
+        if (fd < 0) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+
+        //success
+        return { static_cast<socket::handle_type>(fd), static_cast<socket::handle_type>(fd) };
+    }
+
+
+    //closes the com handles
+    static void close_com_handles(const socket::handle_type* handles) {
+        ::close(static_cast<int>(handles[0]));
+    }
+
+
+    //sends a signal to the com handles
+    static void send_com_signal(socket::handle_type handle) {
+        const uint64_t value = 1;
+        ::write(static_cast<int>(handle), &value, sizeof(value));
+    }
+
+
+    //receives a signal from the com handles; blocks if there is no signal
+    static int receive_com_signal(socket::handle_type handle) {
+        uint64_t value;
+        return static_cast<int>(::read(static_cast<int>(handle), &value, sizeof(value)));
+    }
+
+
+    #else
+
+
+    //creates the com handles; a pipe is used, [0] for reading and [1] for writing
+    static std::array<socket::handle_type, 2> create_com_handles() {
+        //create the pipe
+        int fds[2];
+        if (pipe(fds)) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+
+        //success
+        return { static_cast<socket::handle_type>(fds[0]), static_cast<socket::handle_type>(fds[1]) };
+    }
+
+
+    //closes the com handles
+    static void close_com_handles(const socket::handle_type* handles) {
+        ::close(static_cast<int>(handles[0]));
+        ::close(static_cast<int>(handles[1]));
+    }
+
+
+    //sends a signal to the com handles
+    static void send_com_signal(socket::handle_type handle) {
+        const char buf = 0;
+        ::write(static_cast<int>(handle), &buf, sizeof(buf));
+    }
+
+
+    //receives a signal from the com handles; blocks if there is no signal
+    static int receive_com_signal(socket::handle_type handle) {
+        char buf;
+        return static_cast<int>(::read(static_cast<int>(handle), &buf, sizeof(buf)));
     }
 
 
+    #endif
+
+
+    #if NETLIB_SOCKET_POLLER_EPOLL
+
+
+    //epoll key of the com handle
+    static constexpr uint64_t com_handle_epoll_key = ~uint64_t(0);
+
+
+    //creates the epoll handle and registers the com handle to it
+    static int create_epoll_handle(socket::handle_type com_handle) {
+        //create the epoll handle
+        int epoll_handle = epoll_create1(EPOLL_CLOEXEC);
+
+        //handle error
+        if (epoll_handle < 0) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+
+        //register the com handle
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u64 = com_handle_epoll_key;
+        if (epoll_ctl(epoll_handle, EPOLL_CTL_ADD, static_cast<int>(com_handle), &ev)) {
+            const int error = get_last_error_number();
+            ::close(epoll_handle);
+            throw std::system_error(error, std::system_category());
+        }
+
+        //success
+        return epoll_handle;
+    }
+
+
+    //returns the epoll event mask for the given events
+    static uint32_t get_epoll_events(bool read, bool write) {
+        return (read ? uint32_t(EPOLLIN) : 0u) | (write ? uint32_t(EPOLLOUT) : 0u);
+    }
+
+
+    #endif
+
+
+    #if !NETLIB_SOCKET_POLLER_EPOLL
+
+
+    //poll ignores entries with an invalid handle
+    static const auto invalid_poll_fd = static_cast<decltype(pollfd::fd)>(-1);
+
+
+    //index value for no poll data
+    static constexpr size_t no_poll_index = ~size_t(0);
+
+
+    #endif
+
+
     //the constructor.
     socket_poller::socket_poller(size_t max_sockets)
-        : m_max_sockets(max_sockets + 1) //account for the com socket
-        , m_com_socket(create_com_socket())
-        , m_entries(1) //account for the com socket
-        , m_entries_changed{}
+        : m_max_sockets(max_sockets)
+        , m_com_handles(create_com_handles())
+        , m_com_signal_pending{false}
+        , m_entry_count{0}
         , m_stop{}
         , m_poll_counter{0}
+        #if NETLIB_SOCKET_POLLER_EPOLL
+        , m_epoll_handle(create_epoll_handle(m_com_handles[0]))
+        , m_epoll_serial{0}
+        , m_epoll_events(max_sockets + 1) //account for the com handle
+        #else
+        , m_poll_entries(1) //account for the com handle
+        , m_poll_fds(1)
+        #endif
     {
+        #if !NETLIB_SOCKET_POLLER_EPOLL
+        //set the internal entry; POLLIN, because an eventfd does not report POLLRDNORM
+        m_poll_fds[0].events = POLLIN;
+        m_poll_fds[0].fd = m_com_handles[0];
+        #endif
     }
 
 
     //stop polling.
     socket_poller::~socket_poller() {
         stop();
+        #if NETLIB_SOCKET_POLLER_EPOLL
+        release_ready_entries();
+        ::close(m_epoll_handle);
+        #endif
+        close_com_handles(m_com_handles.data());
+
+        //delete the entries
+        for (auto& [handle, en] : m_entries) {
+            for (entry* e : en.entries) {
+                if (e && release_entry(e)) {
+                    delete e;
+                }
+            }
+        }
+        #if !NETLIB_SOCKET_POLLER_EPOLL
+        for (const poll_change& change : m_poll_changes) {
+            if (change.en && release_entry(change.en)) {
+                delete change.en;
+            }
+        }
+        for (entry* e : m_poll_entries) {
+            if (e && release_entry(e)) {
+                delete e;
+            }
+        }
+        #endif
     }
 
 
     //add entry.
-    bool socket_poller::add(const socket_ptr& s, event_type e, const event_callback_type& cb) {
+    bool socket_poller::add(const socket_ptr& s, event_type e, event_callback_type cb, registration_mode m) {
         //check the socket
         if (!s) {
             throw std::invalid_argument("Invalid socket.");
@@ -97,29 +294,85 @@ namespace netlib {
             throw std::invalid_argument("Empty event callback.");
         }
 
+        //check the registration mode param
+        if (m != registration_mode::level_triggered && m != registration_mode::edge_triggered && m != registration_mode::one_shot) {
+            throw std::invalid_argument("Invalid registration mode.");
+        }
+
+        const socket::handle_type handle = s->handle();
+
+        //create the entry before locking; it is deleted if not added
+        std::unique_ptr<entry> new_entry(new entry{ s, handle, e, m, std::move(cb), 1 });
+
         std::lock_guard lock(m_mutex);
 
         //check the number of entries
-        if (m_entries.size() == m_max_sockets) {
+        if (m_entry_count == m_max_sockets) {
             return false;
         }
 
-        //check if the given socket and event is already added
-        for (entry& en : m_entries) {
-            if (en.socket == s && en.event == e) {
+        //find or create the entry of the socket
+        auto [it, inserted] = m_entries.try_emplace(handle);
+        socket_entry& en = it->second;
+
+        //on new entry, set the socket and the mode
+        if (inserted) {
+            en.socket = s;
+            en.mode = m;
+            en.armed = true;
+            #if NETLIB_SOCKET_POLLER_EPOLL
+            //serial 0 is not used, in order to distinguish sockets from the com handle
+            en.serial = ++m_epoll_serial ? m_epoll_serial : ++m_epoll_serial;
+            #endif
+        }
+
+        //else check if the given socket and event is already added,
+        //and that the other entry of the socket has the same registration mode
+        else {
+            if (en.socket != s) {
+                throw std::invalid_argument("Another socket with the same handle is already added.");
+            }
+            if (en.entries[static_cast<size_t>(e)]) {
                 throw std::invalid_argument("Socket entry already added.");
             }
+            if (en.mode != m) {
+                throw std::invalid_argument("Socket entry registration mode mismatch.");
+            }
         }
 
+        //set the entry
+        en.entries[static_cast<size_t>(e)] = new_entry.get();
+
+        #if NETLIB_SOCKET_POLLER_EPOLL
+        //register the socket event to epoll
+        if (epoll_update(inserted ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, handle, en)) {
+            const int error = get_last_error_number();
+            if (inserted) {
+                m_entries.erase(it);
+            }
+            else {
+                en.entries[static_cast<size_t>(e)] = nullptr;
+            }
+            throw std::system_error(error, std::system_category());
+        }
+        #else
+        //add the entry to the poll data on the next poll
+        m_poll_changes.push_back(poll_change{poll_change_type::add, handle, e, new_entry.get(), en.armed});
+        ++new_entry->ref_count;
+        #endif
+
+        //the entry is owned by the socket entry from now on
+        entry* const added_entry = new_entry.release();
+
         //add the socket
-        m_entries.push_back(entry{s, e, cb});
+        ++m_entry_count;
 
         //set the entries to have changed
         set_entries_changed();
 
         //invoke the socket entry added callback
         if (m_on_socket_entry_added) {
-            m_on_socket_entry_added(m_entries.size() - 1, s, e, cb);
+            m_on_socket_entry_added(m_entry_count, s, e, added_entry->callback);
         }
 
         //success
@@ -129,51 +382,56 @@ namespace netlib {
 
     //remove entry
     void socket_poller::remove(const socket_ptr& s, event_type e) {
+        //check the socket
+        if (!s) {
+            throw std::invalid_argument("Invalid socket.");
+        }
+
         std::lock_guard lock(m_mutex);
 
         //locate the entry
-        auto it = m_entries.begin();
-        for (; it != m_entries.end(); ++it) {
-            entry& en = *it;
-            if (en.socket == s && en.event == e) {
-                break;
-            }
-        }
+        auto it = m_entries.find(s->handle());
 
         //if not found, throw 
-        if (it == m_entries.end()) {
+        if (it == m_entries.end() || it->second.socket != s || !it->second.entries[static_cast<size_t>(e)]) {
             throw std::invalid_argument("Socket entry not found.");
         }
 
         //keep the entry for invoking the event later
-        const entry en = *it;
+        entry* const removed_entry = it->second.entries[static_cast<size_t>(e)];
+        ++removed_entry->ref_count;
+        const std::unique_ptr<entry, void(*)(entry*)> removed_entry_ref(removed_entry, [](entry* en) {
+            if (release_entry(en)) {
+                delete en;
+            }
+            });
 
         //remove the entry
-        m_entries.erase(it);
+        remove_entry(s, e);
 
         //set the entries to have changed
         set_entries_changed();
 
         //invoke the socket entry removed callback
         if (m_on_socket_entry_removed) {
-            m_on_socket_entry_removed(m_entries.size() - 1, en.socket, en.event, en.callback);
+            m_on_socket_entry_removed(m_entry_count, s, e, removed_entry->callback);
         }
     }
 
 
     //remove all entries.
     void socket_poller::remove(const socket_ptr& s) {
+        //check the socket
+        if (!s) {
+            throw std::invalid_argument("Invalid socket.");
+        }
+
         std::lock_guard lock(m_mutex);
 
-        //find and remove entries; iterate backwards so as that index is not invalidated
+        //find and remove entries
         size_t remove_count{};
-        for (size_t index = m_entries.size(); index > 0; --index) {
-            entry& en = m_entries[index - 1];
-            if (en.socket == s) {
-                m_entries.erase(m_entries.begin() + index - 1);
-                ++remove_count;
-            }
-        }
+        remove_count += remove_entry(s, event_type::read);
+        remove_count += remove_entry(s, event_type::write);
 
         //if no entry was removed, throw
         if (!remove_count) {
@@ -185,11 +443,67 @@ namespace netlib {
 
         //invoke the socket removed callback
         if (m_on_socket_removed) {
-            m_on_socket_removed(m_entries.size() - 1, s);
+            m_on_socket_removed(m_entry_count, s);
         }
     }
 
 
+    //re-arm one-shot socket.
+    void socket_poller::rearm(const socket_ptr& s) {
+        //check the socket
+        if (!s) {
+            throw std::invalid_argument("Invalid socket.");
+        }
+
+        std::lock_guard lock(m_mutex);
+
+        //find the entry of the socket
+        auto it = m_entries.find(s->handle());
+
+        //if no entry was found, throw
+        if (it == m_entries.end() || it->second.socket != s) {
+            throw std::invalid_argument("Socket not found.");
+        }
+
+        //only one-shot sockets can be re-armed
+        socket_entry& en = it->second;
+        if (en.mode != registration_mode::one_shot) {
+            throw std::invalid_argument("Socket not added in one-shot mode.");
+        }
+
+        //re-enable the socket
+        en.armed = true;
+
+        #if NETLIB_SOCKET_POLLER_EPOLL
+        if (epoll_update(EPOLL_CTL_MOD, it->first, en)) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+        #else
+        //re-enable the poll data on the next poll
+        m_poll_changes.push_back(poll_change{poll_change_type::rearm, it->first, event_type::read, nullptr, true});
+        set_entries_changed();
+        #endif
+    }
+
+
+    //Returns the number of socket entries.
+    size_t socket_poller::entry_count() const {
+        std::lock_guard lock(m_mutex);
+        return m_entry_count;
+    }
+
+
+    //Checks if the given socket has entries in this poller.
+    bool socket_poller::contains(const socket_ptr& s) const {
+        if (!s) {
+            return false;
+        }
+        std::lock_guard lock(m_mutex);
+        auto it = m_entries.find(s->handle());
+        return it != m_entries.end() && it->second.socket == s;
+    }
+
+
     //poll.
     socket_poller::poll_status socket_poller::poll(int timeout_ms) {
         //use RAII to manage poll counter increments
@@ -204,14 +518,27 @@ namespace netlib {
                 return poll_status::stopped;
             }
 
-            //if there are no entries, wait for internal socket entry;
-            //account for the com socket
-            while (m_entries.size() - 1 == 0) {
+            //if there are no entries, wait for a signal on the com handle
+            while (m_entry_count == 0) {
                 m_mutex.unlock();
 
-                //wait for data
-                char buf;
-                int s = recv(m_com_socket, &buf, sizeof(buf), 0);
+                //if there is a timeout, wait for a signal up to the timeout
+                if (timeout_ms >= 0) {
+                    pollfd com_fd{};
+                    com_fd.fd = m_com_handles[0];
+                    com_fd.events = POLLIN;
+                    const int poll_result = ::poll(&com_fd, 1, timeout_ms);
+                    if (poll_result == 0) {
+                        return poll_status::timeout;
+                    }
+                    if (poll_result < 0) {
+                        throw std::system_error(get_last_error_number(), std::system_category());
+                    }
+                }
+
+                //wait for a signal
+                int s = receive_com_signal(m_com_handles[0]);
+                m_com_signal_pending = false;
 
                 //if there was an error
                 if (s <= 0) {
@@ -223,48 +550,58 @@ namespace netlib {
 
                 //no error
                 m_mutex.lock();
-            }
-
-            m_mutex.unlock();
-
-            std::lock_guard lock(m_mutex);
-
-            //if changed, rebuild the m_poll_entries/m_poll_fds arrays
-            if (m_entries_changed) {
-                m_entries_changed = false;
-
-                //make room for new entries
-                m_poll_entries.resize(m_entries.size());
-                m_poll_fds.resize(m_entries.size());
 
-                //set the internal entry
-                m_poll_fds[0].events = POLLRDNORM;
-                m_poll_fds[0].fd = m_com_socket;
-
-                //set m_poll_entries
-                for (size_t i = 1; i < m_entries.size(); ++i) {
-                    m_poll_entries[i] = m_entries[i];
-                    m_poll_fds[i].events = m_entries[i].event == event_type::read ? POLLRDNORM : POLLWRNORM;
-                    m_poll_fds[i].fd = m_entries[i].socket->handle();
+                //if stopped while waiting
+                if (m_stop) {
+                    m_mutex.unlock();
+                    return poll_status::stopped;
                 }
             }
+
+            #if !NETLIB_SOCKET_POLLER_EPOLL
+            //if changed, update the m_poll_entries/m_poll_fds arrays
+            if (!m_poll_changes.empty()) {
+                apply_poll_changes();
+            }
+            #endif
+
+            m_mutex.unlock();
         }
 
+        #if NETLIB_SOCKET_POLLER_EPOLL
+        //epoll maintains the registered sockets by itself
+        return epoll(timeout_ms);
+        #else
+
         //poll
         int poll_result = ::poll(m_poll_fds.data(), numeric_cast<unsigned int>(m_poll_fds.size()), timeout_ms);
 
         //process events
         if (poll_result > 0) {
-            //process the internal com socket
+            //process the internal com handle
             if (m_poll_fds[0].revents) {
-                char buf;
-                recv(m_com_socket, &buf, sizeof(buf), 0);
+                receive_com_signal(m_com_handles[0]);
+                m_com_signal_pending = false;
                 --poll_result;
             }
 
             //process entries
             for (size_t i = 1; i < m_poll_fds.size() && poll_result > 0; ++i) {
                 if (m_poll_fds[i].revents) {
+                    //count one less socket to check
+                    --poll_result;
+
+                    //skip the entry if its socket was disarmed by a previous one-shot event
+                    if (m_poll_fds[i].fd == invalid_poll_fd) {
+                        continue;
+                    }
+
+                    //disable the entries of a one-shot socket before invoking the callback,
+                    //so as that the callback can re-arm the socket
+                    if (m_poll_entries[i]->mode == registration_mode::one_shot) {
+                        disarm(*m_poll_entries[i]);
+                    }
+
                     //set the flags
                     status_flags flags;
                     flags.error              = m_poll_fds[i].revents & POLLERR;
@@ -272,12 +609,18 @@ namespace netlib {
                     flags.invalid_socket     = m_poll_fds[i].revents & POLLNVAL;
 
                     //invoke the callback
-                    m_poll_entries[i].callback(*this, m_poll_entries[i].socket, m_poll_entries[i].event, flags);
+                    invoke_callback(*m_poll_entries[i], flags);
+                }
+            }
 
-                    //count one less socket to check
-                    --poll_result;
+            //apply the changes made by the callbacks, so as that the removed sockets are released now
+            {
+                std::lock_guard lock(m_mutex);
+                if (!m_poll_changes.empty()) {
+                    apply_poll_changes();
                 }
             }
+
             return poll_status::success;
         }
 
@@ -288,6 +631,7 @@ namespace netlib {
 
         //error
         throw std::runtime_error(get_last_error_message());
+        #endif
     }
 
 
@@ -323,17 +667,335 @@ namespace netlib {
             
             m_stop = true;
         }
-        char buf = 0;
-        ::send(m_com_socket, &buf, sizeof(buf), 0);
+        signal_com_handle();
     }
 
 
     //sets the entries as changed
     void socket_poller::set_entries_changed() {
-        m_entries_changed = true;
-        char buf = 0;
-        ::send(m_com_socket, &buf, sizeof(buf), 0);
+        #if NETLIB_SOCKET_POLLER_EPOLL
+        //epoll sees registration changes without waking up;
+        //only a poll waiting for the first entry needs to be woken up
+        if (m_entry_count != 1) {
+            return;
+        }
+        #endif
+
+        signal_com_handle();
+    }
+
+
+    //wakes up the polling thread; multiple signals are coalesced into one,
+    //until the polling thread receives the signal
+    void socket_poller::signal_com_handle() {
+        if (!m_com_signal_pending.exchange(true)) {
+            send_com_signal(m_com_handles[1]);
+        }
+    }
+
+
+    //invokes the callback of an entry; the callback of a level-triggered read entry is invoked again
+    //while the socket has received data buffered in user space, as long as the callback consumes them,
+    //because the operating system does not report the socket as readable for these data
+    void socket_poller::invoke_callback(const entry& en, status_flags flags) {
+        en.callback(*this, en.socket, en.event, flags);
+
+        if (en.event != event_type::read || en.mode != registration_mode::level_triggered) {
+            return;
+        }
+
+        for (size_t size = en.socket->buffered_receive_size(); size > 0; ) {
+            //stop if the entry was removed by the callback
+            {
+                std::lock_guard lock(m_mutex);
+                auto it = m_entries.find(en.handle);
+                if (it == m_entries.end() || it->second.entries[static_cast<size_t>(event_type::read)] != &en) {
+                    return;
+                }
+            }
+
+            en.callback(*this, en.socket, en.event, status_flags{});
+
+            //stop if the callback did not consume any data
+            const size_t new_size = en.socket->buffered_receive_size();
+            if (new_size >= size) {
+                return;
+            }
+            size = new_size;
+        }
+    }
+
+
+    //removes the entry of the given socket and event
+    bool socket_poller::remove_entry(const socket_ptr& s, event_type e) {
+        //locate the entry
+        auto it = m_entries.find(s->handle());
+        if (it == m_entries.end() || it->second.socket != s || !it->second.entries[static_cast<size_t>(e)]) {
+            return false;
+        }
+        socket_entry& en = it->second;
+
+        //release the entry; the dispatch data might still reference it
+        entry* const removed_entry = std::exchange(en.entries[static_cast<size_t>(e)], nullptr);
+        if (release_entry(removed_entry)) {
+            delete removed_entry;
+        }
+        --m_entry_count;
+
+        #if NETLIB_SOCKET_POLLER_EPOLL
+        //if there are no more events for the socket, remove it from epoll;
+        //errors are ignored, since the socket might already be closed
+        if (!en.entries[0] && !en.entries[1]) {
+            epoll_ctl(m_epoll_handle, EPOLL_CTL_DEL, static_cast<int>(it->first), nullptr);
+            m_entries.erase(it);
+        }
+
+        //else modify the registered events
+        else {
+            epoll_update(EPOLL_CTL_MOD, it->first, en);
+        }
+        #else
+        //remove the entry from the poll data on the next poll
+        m_poll_changes.push_back(poll_change{poll_change_type::remove, it->first, e, nullptr, false});
+
+        //if there are no more events for the socket, remove the socket entry
+        if (!en.entries[0] && !en.entries[1]) {
+            m_entries.erase(it);
+        }
+        #endif
+
+        return true;
     }
 
 
+    //releases a reference to an entry
+    bool socket_poller::release_entry(entry* en) {
+        return --en->ref_count == 0;
+    }
+
+
+    #if NETLIB_SOCKET_POLLER_EPOLL
+
+
+    //invokes epoll_ctl for the given entry
+    int socket_poller::epoll_update(int op, socket::handle_type handle, const socket_entry& en) {
+        epoll_event ev{};
+
+        //a disarmed one-shot socket stays registered without events
+        ev.events = en.armed ? get_epoll_events(en.entries[0], en.entries[1]) : 0;
+
+        //set the mode
+        switch (en.mode) {
+        case registration_mode::level_triggered:
+            break;
+        case registration_mode::edge_triggered:
+            ev.events |= EPOLLET;
+            break;
+        case registration_mode::one_shot:
+            ev.events |= EPOLLONESHOT;
+            break;
+        }
+
+        //the key contains the serial and the handle
+        ev.data.u64 = (static_cast<uint64_t>(en.serial) << 32) | static_cast<uint32_t>(handle);
+
+        return epoll_ctl(m_epoll_handle, op, static_cast<int>(handle), &ev);
+    }
+
+
+    //waits for epoll events and dispatches them
+    socket_poller::poll_status socket_poller::epoll(int timeout_ms) {
+        //wait; only the ready sockets are returned
+        int poll_result = epoll_wait(m_epoll_handle, m_epoll_events.data(), numeric_cast<int>(m_epoll_events.size()), timeout_ms);
+
+        //process events
+        if (poll_result > 0) {
+            //release the entries left by a callback that threw
+            release_ready_entries();
+
+            //collect the entries of the ready sockets, under lock, since sockets might be removed concurrently
+            {
+                std::lock_guard lock(m_mutex);
+
+                for (int i = 0; i < poll_result; ++i) {
+                    const epoll_event& ev = m_epoll_events[i];
+
+                    //process the internal com handle
+                    if (ev.data.u64 == com_handle_epoll_key) {
+                        receive_com_signal(m_com_handles[0]);
+                        m_com_signal_pending = false;
+                        continue;
+                    }
+
+                    //find the entry; skip the event if the socket was removed after the event was reported
+                    auto it = m_entries.find(static_cast<socket::handle_type>(ev.data.u64 & 0xffffffff));
+                    if (it == m_entries.end() || it->second.serial != (ev.data.u64 >> 32)) {
+                        continue;
+                    }
+                    socket_entry& en = it->second;
+
+                    //epoll disabled the one-shot socket; keep the state so as that modifications do not re-arm it
+                    if (en.mode == registration_mode::one_shot) {
+                        en.armed = false;
+                    }
+
+                    //set the flags
+                    status_flags flags;
+                    flags.error              = ev.events & EPOLLERR;
+                    flags.connection_aborted = ev.events & EPOLLHUP;
+                    flags.invalid_socket     = false;
+
+                    //read event; errors are reported to both events, as with poll
+                    entry* const read_entry = en.entries[static_cast<size_t>(event_type::read)];
+                    if (read_entry && (ev.events & (EPOLLIN | EPOLLERR | EPOLLHUP))) {
+                        m_ready_entries.push_back(ready_entry{read_entry, flags});
+                        ++read_entry->ref_count;
+                    }
+
+                    //write event
+                    entry* const write_entry = en.entries[static_cast<size_t>(event_type::write)];
+                    if (write_entry && (ev.events & (EPOLLOUT | EPOLLERR | EPOLLHUP))) {
+                        m_ready_entries.push_back(ready_entry{write_entry, flags});
+                        ++write_entry->ref_count;
+                    }
+                }
+            }
+
+            //invoke the callbacks
+            for (const ready_entry& en : m_ready_entries) {
+                invoke_callback(*en.en, en.flags);
+            }
+
+            //release the entries
+            release_ready_entries();
+
+            return poll_status::success;
+        }
+
+        //timeout
+        if (poll_result == 0) {
+            return poll_status::timeout;
+        }
+
+        //interrupted by a signal; treat it as a timeout
+        if (get_last_error_number() == EINTR) {
+            return poll_status::timeout;
+        }
+
+        //error
+        throw std::runtime_error(get_last_error_message());
+    }
+
+
+    //releases the entries of the ready entries; the entries that are no longer referenced
+    //are deleted without the lock, since deleting them might close their sockets
+    void socket_poller::release_ready_entries() {
+        if (m_ready_entries.empty()) {
+            return;
+        }
+
+        size_t unreferenced_count = 0;
+        {
+            std::lock_guard lock(m_mutex);
+            for (const ready_entry& en : m_ready_entries) {
+                if (release_entry(en.en)) {
+                    m_ready_entries[unreferenced_count++].en = en.en;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < unreferenced_count; ++i) {
+            delete m_ready_entries[i].en;
+        }
+        m_ready_entries.clear();
+    }
+
+
+    #else
+
+
+    //applies the pending changes to the poll data; each change costs O(1)
+    void socket_poller::apply_poll_changes() {
+        for (poll_change& change : m_poll_changes) {
+            switch (change.type) {
+            //append the entry to the poll data
+            case poll_change_type::add: {
+                auto [it, inserted] = m_poll_indexes.try_emplace(change.handle, std::array<size_t, 2>{no_poll_index, no_poll_index});
+                it->second[static_cast<size_t>(change.event)] = m_poll_fds.size();
+                pollfd fd{};
+                fd.fd = change.armed ? change.handle : invalid_poll_fd;
+                fd.events = change.event == event_type::read ? POLLRDNORM : POLLWRNORM;
+                m_poll_fds.push_back(fd);
+                m_poll_entries.push_back(change.en);
+                break;
+            }
+
+            //replace the entry with the last entry of the poll data
+            case poll_change_type::remove: {
+                auto it = m_poll_indexes.find(change.handle);
+                const size_t index = it->second[static_cast<size_t>(change.event)];
+                const size_t last_index = m_poll_fds.size() - 1;
+                entry* const removed_entry = m_poll_entries[index];
+                if (index != last_index) {
+                    m_poll_fds[index] = m_poll_fds[last_index];
+                    m_poll_entries[index] = m_poll_entries[last_index];
+                    m_poll_indexes[m_poll_entries[index]->handle][static_cast<size_t>(m_poll_entries[index]->event)] = index;
+                }
+                m_poll_fds.pop_back();
+                m_poll_entries.pop_back();
+                if (release_entry(removed_entry)) {
+                    delete removed_entry;
+                }
+                it->second[static_cast<size_t>(change.event)] = no_poll_index;
+                if (it->second[0] == no_poll_index && it->second[1] == no_poll_index) {
+                    m_poll_indexes.erase(it);
+                }
+                break;
+            }
+
+            //re-enable the entries of the socket
+            case poll_change_type::rearm: {
+                auto it = m_poll_indexes.find(change.handle);
+                if (it != m_poll_indexes.end()) {
+                    for (size_t index : it->second) {
+                        if (index != no_poll_index) {
+                            m_poll_fds[index].fd = change.handle;
+                        }
+                    }
+                }
+                break;
+            }
+            }
+        }
+
+        m_poll_changes.clear();
+    }
+
+
+    //disables the entries of the given socket, after a one-shot event
+    void socket_poller::disarm(const entry& en) {
+        //disable the socket entry
+        {
+            std::lock_guard lock(m_mutex);
+            auto it = m_entries.find(en.handle);
+            if (it != m_entries.end() && it->second.socket == en.socket) {
+                it->second.armed = false;
+            }
+        }
+
+        //disable the poll data of the socket, for the entries that are not yet processed
+        auto it = m_poll_indexes.find(en.handle);
+        if (it != m_poll_indexes.end()) {
+            for (size_t index : it->second) {
+                if (index != no_poll_index) {
+                    m_poll_fds[index].fd = invalid_poll_fd;
+                }
+            }
+        }
+    }
+
+
+    #endif
+
+
 } //namespace netlib
@@ -0,0 +1,205 @@
+#include "platform.hpp"
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include "netlib/socket_poller_group.hpp"
+
+
+namespace netlib {
+
+
+    //binds the given thread to the given core
+    static void pin_thread(socket_poller_thread& thread, size_t core) {
+        #ifdef _WIN32
+        if (!SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << core)) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+        #elif defined(__linux__)
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(core, &cpu_set);
+        if (const int error = pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set), &cpu_set)) {
+            throw std::system_error(error, std::system_category());
+        }
+        #endif
+    }
+
+
+    //Constructor.
+    socket_poller_group::socket_poller_group(size_t thread_count, distribution_policy policy, bool pin_threads, size_t max_sockets)
+        : socket_poller_group(thread_count, get_distribution_function(policy), pin_threads, max_sockets)
+    {
+    }
+
+
+    //Constructor.
+    socket_poller_group::socket_poller_group(size_t thread_count, const distribution_function& distribution, bool pin_threads, size_t max_sockets)
+        : m_distribution(distribution)
+    {
+        //check the distribution function
+        if (!distribution) {
+            throw std::invalid_argument("Empty distribution function.");
+        }
+
+        //number of cores
+        const size_t core_count = std::max(std::thread::hardware_concurrency(), 1u);
+
+        //by default, use one thread per core
+        if (!thread_count) {
+            thread_count = core_count;
+        }
+
+        //create the threads
+        m_pollers.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; ++i) {
+            m_pollers.push_back(std::make_unique<socket_poller_thread>(max_sockets));
+            if (pin_threads) {
+                pin_thread(*m_pollers.back(), i % core_count);
+            }
+        }
+    }
+
+
+    //Stops the socket poller threads and waits for their termination.
+    socket_poller_group::~socket_poller_group() {
+        stop();
+    }
+
+
+    //Adds a socket entry.
+    bool socket_poller_group::add(const socket_ptr& s, event_type e, event_callback_type cb, registration_mode m) {
+        //check the socket
+        if (!s) {
+            throw std::invalid_argument("Invalid socket.");
+        }
+
+        std::lock_guard lock(m_mutex);
+
+        //if the socket already has entries, add the entry to the same poller
+        if (socket_poller_thread* poller = find_poller(s)) {
+            return poller->add(s, e, std::move(cb), m);
+        }
+
+        //else select the poller
+        const size_t index = m_distribution(*this, s);
+        if (index >= m_pollers.size()) {
+            throw std::out_of_range("Invalid socket poller index.");
+        }
+
+        return m_pollers[index]->add(s, e, std::move(cb), m);
+    }
+
+
+    //Removes a socket entry.
+    void socket_poller_group::remove(const socket_ptr& s, event_type e) {
+        std::lock_guard lock(m_mutex);
+
+        //find the poller
+        socket_poller_thread* poller = find_poller(s);
+        if (!poller) {
+            throw std::invalid_argument("Socket entry not found.");
+        }
+
+        poller->remove(s, e);
+    }
+
+
+    //Removes all the entries for the given socket.
+    void socket_poller_group::remove(const socket_ptr& s) {
+        //check the socket
+        if (!s) {
+            throw std::invalid_argument("Invalid socket.");
+        }
+
+        std::lock_guard lock(m_mutex);
+
+        //find the poller
+        socket_poller_thread* poller = find_poller(s);
+        if (!poller) {
+            throw std::runtime_error("Socket not found.");
+        }
+
+        poller->remove(s);
+    }
+
+
+    //Re-enables the entries of a one-shot socket.
+    void socket_poller_group::rearm(const socket_ptr& s) {
+        std::lock_guard lock(m_mutex);
+
+        //find the poller
+        socket_poller_thread* poller = find_poller(s);
+        if (!poller) {
+            throw std::invalid_argument("Socket not found.");
+        }
+
+        poller->rearm(s);
+    }
+
+
+    //Stops the socket poller threads.
+    void socket_poller_group::stop() {
+        //signal all the threads first, so as that they stop in parallel
+        for (const std::unique_ptr<socket_poller_thread>& poller : m_pollers) {
+            poller->socket_poller::stop();
+        }
+
+        //wait for the threads
+        for (const std::unique_ptr<socket_poller_thread>& poller : m_pollers) {
+            poller->stop();
+        }
+    }
+
+
+    //Waits for the socket poller threads to terminate.
+    void socket_poller_group::join() {
+        for (const std::unique_ptr<socket_poller_thread>& poller : m_pollers) {
+            poller->join();
+        }
+    }
+
+
+    //returns the poller that contains the given socket
+    socket_poller_thread* socket_poller_group::find_poller(const socket_ptr& s) const {
+        for (const std::unique_ptr<socket_poller_thread>& poller : m_pollers) {
+            if (poller->contains(s)) {
+                return poller.get();
+            }
+        }
+        return nullptr;
+    }
+
+
+    //creates the distribution function of the given policy
+    socket_poller_group::distribution_function socket_poller_group::get_distribution_function(distribution_policy policy) {
+        switch (policy) {
+        case distribution_policy::round_robin:
+            return [index = size_t{0}](const socket_poller_group& group, const socket_ptr&) mutable {
+                return index++ % group.size();
+            };
+
+        case distribution_policy::least_loaded:
+            return [](const socket_poller_group& group, const socket_ptr&) {
+                size_t result = 0;
+                size_t min_entry_count = group.poller(0).entry_count();
+                for (size_t i = 1; i < group.size() && min_entry_count > 0; ++i) {
+                    const size_t entry_count = group.poller(i).entry_count();
+                    if (entry_count < min_entry_count) {
+                        min_entry_count = entry_count;
+                        result = i;
+                    }
+                }
+                return result;
+            };
+
+        case distribution_policy::hash:
+            return [](const socket_poller_group& group, const socket_ptr& s) {
+                return std::hash<socket::handle_type>()(s->handle()) % group.size();
+            };
+        }
+
+        throw std::invalid_argument("Invalid distribution policy.");
+    }
+
+
+} //namespace netlib
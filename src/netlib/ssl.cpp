@@ -23,15 +23,21 @@ namespace netlib::ssl {
             return ssl_io_result::failure;
         }
 
-        //for these values, throw custom error
+        //for these values, the socket must be polled before the operation is repeated
         switch (error) {
         case SSL_ERROR_WANT_READ:
+        case SSL_ERROR_WANT_ACCEPT:
+            return ssl_io_result::want_read;
         case SSL_ERROR_WANT_WRITE:
         case SSL_ERROR_WANT_CONNECT:
-        case SSL_ERROR_WANT_ACCEPT:
+            return ssl_io_result::want_write;
+        }
+
+        //for these values, throw custom error
+        switch (error) {
         case SSL_ERROR_WANT_ASYNC:
         case SSL_ERROR_WANT_ASYNC_JOB:
-            throw std::logic_error("Non-blocking SSL I/O unsupported.");
+            throw std::logic_error("Asynchronous SSL I/O unsupported.");
         }
 
         //for these values, repeat
@@ -66,6 +72,12 @@ namespace netlib::ssl {
 
     //does shutdown/SSL_free/close socket.
     void SSL_close(SSL* ssl) {
+        //the handshake was not completed; there is no session to shut down
+        if (!SSL_is_init_finished(ssl)) {
+            SSL_destructor(ssl);
+            return;
+        }
+
         const int r = SSL_shutdown(ssl);
 
         //normal shutdown
@@ -97,14 +109,19 @@ namespace netlib::ssl {
                     SSL_destructor(ssl);
                     return;
 
-                //no support for async
+                //non-blocking socket; the close notification of the peer is not waited for
                 case SSL_ERROR_WANT_READ:
                 case SSL_ERROR_WANT_WRITE:
                 case SSL_ERROR_WANT_CONNECT:
                 case SSL_ERROR_WANT_ACCEPT:
+                    SSL_destructor(ssl);
+                    return;
+
+                //no support for async
                 case SSL_ERROR_WANT_ASYNC:
                 case SSL_ERROR_WANT_ASYNC_JOB:
-                    throw std::logic_error("Non-blocking SSL I/O unsupported.");
+                    SSL_destructor(ssl);
+                    throw std::logic_error("Asynchronous SSL I/O unsupported.");
 
                 //retry
                 case SSL_ERROR_WANT_X509_LOOKUP:
@@ -140,15 +157,20 @@ namespace netlib::ssl {
             throw ssl::error("Zero return error returned by SSL_get_error althrough SSL_shutdown returned value < 0.");
         }
 
-        //for these values, throw custom error
+        //non-blocking socket; the close notification could not be sent without blocking
         switch (error) {
         case SSL_ERROR_WANT_READ:
         case SSL_ERROR_WANT_WRITE:
         case SSL_ERROR_WANT_CONNECT:
         case SSL_ERROR_WANT_ACCEPT:
+            return;
+        }
+
+        //for these values, throw custom error
+        switch (error) {
         case SSL_ERROR_WANT_ASYNC:
         case SSL_ERROR_WANT_ASYNC_JOB:
-            throw std::logic_error("Non-blocking SSL I/O unsupported.");
+            throw std::logic_error("Asynchronous SSL I/O unsupported.");
         }
 
         //for these values, throw ssl error
@@ -173,6 +195,47 @@ namespace netlib::ssl {
     }
 
 
+    //sends the close notification, then does SSL_free/close socket; for datagram sockets.
+    void DTLS_close(SSL* ssl) {
+        //the close notification of the other side is not waited for, since it might be lost
+        if (SSL_is_init_finished(ssl)) {
+            SSL_shutdown(ssl);
+            ERR_clear_error();
+        }
+        SSL_destructor(ssl);
+    }
+
+
+    //do the handshake of a blocking dtls connection
+    void dtls_handshake(SSL* ssl) {
+        for (;;) {
+            const int r = SSL_do_handshake(ssl);
+
+            //success
+            if (r == 1) {
+                return;
+            }
+
+            switch (ssl_handle_io_error(ssl, r)) {
+            //closed by the other side
+            case ssl_io_result::failure:
+                throw ssl::error("Connection closed during the handshake.");
+
+            //the retransmission timer expired; resend the last messages
+            case ssl_io_result::want_read:
+            case ssl_io_result::want_write:
+                if (DTLSv1_handle_timeout(ssl) < 0) {
+                    throw ssl::error(ERR_get_error());
+                }
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+
+
     //send data
     bool ssl_send(SSL* ssl, const char* d, int len) {
         do {
@@ -191,6 +254,11 @@ namespace netlib::ssl {
                 return true;
             case ssl_io_result::failure:
                 return false;
+            case ssl_io_result::want_read:
+            case ssl_io_result::want_write:
+                throw std::logic_error("Blocking SSL I/O on a non-blocking socket.");
+            default:
+                break;
             }
 
         } while (len > 0);
@@ -217,6 +285,11 @@ namespace netlib::ssl {
                 return true;
             case ssl_io_result::failure:
                 return false;
+            case ssl_io_result::want_read:
+            case ssl_io_result::want_write:
+                throw std::logic_error("Blocking SSL I/O on a non-blocking socket.");
+            default:
+                break;
             }
 
         } while (len > 0);
@@ -225,4 +298,119 @@ namespace netlib::ssl {
     }
 
 
+    //receive the available data
+    int ssl_receive_available(SSL* ssl, char* d, int len) {
+        for (;;) {
+            //receive
+            int s = SSL_read(ssl, d, len);
+
+            //success
+            if (s > 0) {
+                return s;
+            }
+
+            switch (ssl_handle_io_error(ssl, s)) {
+            case ssl_io_result::failure:
+                return 0;
+            case ssl_io_result::want_read:
+            case ssl_io_result::want_write:
+                throw std::logic_error("Blocking SSL I/O on a non-blocking socket.");
+            default:
+                break;
+            }
+        }
+    }
+
+
+    //send as much data as possible without blocking
+    ssl_io_result ssl_send_available(SSL* ssl, const char* d, int len, int& sent) {
+        sent = 0;
+
+        while (len > 0) {
+            //send
+            const int s = SSL_write(ssl, d, len);
+
+            //success
+            if (s > 0) {
+                d += s;
+                len -= s;
+                sent += s;
+                continue;
+            }
+
+            //closed, or the socket must be polled
+            const ssl_io_result result = ssl_handle_io_error(ssl, s);
+            if (result != ssl_io_result::retry) {
+                return result;
+            }
+        }
+
+        return ssl_io_result::success;
+    }
+
+
+    //do the handshake without blocking
+    ssl_io_result ssl_handshake(SSL* ssl) {
+        for (;;) {
+            const int r = SSL_do_handshake(ssl);
+
+            //success
+            if (r == 1) {
+                return ssl_io_result::success;
+            }
+
+            //closed, or the socket must be polled
+            const ssl_io_result result = ssl_handle_io_error(ssl, r);
+            if (result != ssl_io_result::retry) {
+                return result;
+            }
+        }
+    }
+
+
+    //do the bidirectional shutdown without blocking
+    ssl_io_result ssl_shutdown(SSL* ssl) {
+        //send the close notification, if not sent yet or if sending it was interrupted
+        if (!(SSL_get_shutdown(ssl) & SSL_SENT_SHUTDOWN) || SSL_want_write(ssl)) {
+            const int r = SSL_shutdown(ssl);
+
+            //both sides have sent the close notification
+            if (r == 1) {
+                return ssl_io_result::success;
+            }
+
+            //the close notification could not be sent
+            if (r < 0) {
+                const ssl_io_result result = ssl_handle_io_error(ssl, r);
+                if (result == ssl_io_result::want_read || result == ssl_io_result::want_write) {
+                    return result;
+                }
+            }
+        }
+
+        //receive the close notification of the peer, discarding any data received before it
+        char buf[64];
+        while (!(SSL_get_shutdown(ssl) & SSL_RECEIVED_SHUTDOWN)) {
+            const int s = SSL_read(ssl, buf, sizeof(buf));
+
+            //discard the data
+            if (s > 0) {
+                continue;
+            }
+
+            switch (const ssl_io_result result = ssl_handle_io_error(ssl, s)) {
+            case ssl_io_result::failure:
+                return ssl_io_result::success;
+            case ssl_io_result::want_read:
+            case ssl_io_result::want_write:
+                return result;
+            default:
+                break;
+            }
+        }
+
+        return ssl_io_result::success;
+    }
+
+
 } //namespace netlib::ssl
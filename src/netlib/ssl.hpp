@@ -4,6 +4,8 @@
 
 #include "openssl/ssl.h"
 #include "openssl/err.h"
+#include <string>
+#include "netlib/socket_address.hpp"
 
 
 namespace netlib::ssl {
@@ -13,7 +15,9 @@ namespace netlib::ssl {
     enum class ssl_io_result {
         failure,
         success,
-        retry
+        retry,
+        want_read,
+        want_write
     };
 
 
@@ -25,6 +29,14 @@ namespace netlib::ssl {
     void SSL_close(SSL* ssl);
 
 
+    //sends the close notification without waiting for the one of the other side, then does SSL_free/close socket; for datagram sockets.
+    void DTLS_close(SSL* ssl);
+
+
+    //do the handshake of a blocking dtls connection, retransmitting the lost handshake messages
+    void dtls_handshake(SSL* ssl);
+
+
     //send data
     bool ssl_send(SSL* ssl, const char* d, int len);
 
@@ -33,6 +45,26 @@ namespace netlib::ssl {
     bool ssl_receive(SSL* ssl, char* d, int len);
 
 
+    //receive the available data; returns 0 if the connection is closed
+    int ssl_receive_available(SSL* ssl, char* d, int len);
+
+
+    //send as much data as possible without blocking; returns success if all the data are sent
+    ssl_io_result ssl_send_available(SSL* ssl, const char* d, int len, int& sent);
+
+
+    //do the handshake without blocking
+    ssl_io_result ssl_handshake(SSL* ssl);
+
+
+    //do the bidirectional shutdown without blocking
+    ssl_io_result ssl_shutdown(SSL* ssl);
+
+
+    //prepare the ssl for resuming the session stored for the given server, and for storing the new sessions
+    void ssl_resume_session(SSL* ssl, const socket_address& server_addr, const std::string& server_name);
+
+
     } //namespace netlib::ssl
 
 
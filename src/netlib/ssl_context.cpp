@@ -1,4 +1,6 @@
 #include "ssl.hpp"
+#include <mutex>
+#include "openssl/pem.h"
 #include "netlib/ssl_context.hpp"
 #include "netlib/ssl_error.hpp"
 
@@ -6,6 +8,117 @@
 namespace netlib::ssl {
 
 
+    //certificate loaded with context::load_certificate()
+    struct certificate {
+        X509* cert{ nullptr };
+        EVP_PKEY* key{ nullptr };
+        STACK_OF(X509)* chain{ nullptr };
+
+        ~certificate() {
+            X509_free(cert);
+            EVP_PKEY_free(key);
+            sk_X509_pop_free(chain, X509_free);
+        }
+    };
+
+
+    //current certificate of an SSL_CTX; null until a certificate is loaded
+    struct certificate_holder {
+        std::mutex mutex;
+        std::shared_ptr<const certificate> current;
+
+        std::shared_ptr<const certificate> get() {
+            std::lock_guard lock(mutex);
+            return current;
+        }
+
+        void set(const std::shared_ptr<const certificate>& cert) {
+            std::lock_guard lock(mutex);
+            current = cert;
+        }
+    };
+
+
+    //frees the certificate holder of an SSL_CTX
+    static void free_certificate_holder(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+        delete static_cast<certificate_holder*>(ptr);
+    }
+
+
+    //index of the certificate holder in SSL_CTX ex data
+    static int get_certificate_holder_index() {
+        static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, free_certificate_holder);
+        return index;
+    }
+
+
+    //returns the certificate holder of an SSL_CTX
+    static certificate_holder& get_certificate_holder(SSL_CTX* ctx) {
+        return *static_cast<certificate_holder*>(SSL_CTX_get_ex_data(ctx, get_certificate_holder_index()));
+    }
+
+
+    //invoked by OpenSSL when the certificate is needed for a handshake; it sets the last loaded certificate
+    static int certificate_callback(SSL* ssl, void*) {
+        const std::shared_ptr<const certificate> cert = get_certificate_holder(SSL_get_SSL_CTX(ssl)).get();
+        if (!cert) {
+            return 1;
+        }
+        return SSL_use_cert_and_key(ssl, cert->cert, cert->key, cert->chain, 1) == 1 ? 1 : 0;
+    }
+
+
+    //opens a file for reading
+    static std::unique_ptr<BIO, decltype(&BIO_free)> open_file(const char* file) {
+        std::unique_ptr<BIO, decltype(&BIO_free)> bio{ BIO_new_file(file, "r"), BIO_free };
+        if (!bio) {
+            throw error(ERR_get_error());
+        }
+        return bio;
+    }
+
+
+    //loads a certificate, its chain and its key
+    static std::shared_ptr<const certificate> read_certificate(const char* certificate_file, const char* key_file) {
+        std::shared_ptr<certificate> cert = std::make_shared<certificate>();
+
+        //load the certificate and its chain
+        auto bio = open_file(certificate_file);
+        cert->cert = PEM_read_bio_X509(bio.get(), nullptr, nullptr, nullptr);
+        if (!cert->cert) {
+            throw error(ERR_get_error());
+        }
+        cert->chain = sk_X509_new_null();
+        if (!cert->chain) {
+            throw error(ERR_get_error());
+        }
+        while (X509* ca = PEM_read_bio_X509(bio.get(), nullptr, nullptr, nullptr)) {
+            if (!sk_X509_push(cert->chain, ca)) {
+                X509_free(ca);
+                throw error(ERR_get_error());
+            }
+        }
+
+        //the end of the file is reported as an error
+        ERR_clear_error();
+
+        //load the private key
+        bio = open_file(key_file);
+        cert->key = PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr);
+        if (!cert->key) {
+            throw error(ERR_get_error());
+        }
+
+        //verify the private key
+        if (!X509_check_private_key(cert->cert, cert->key)) {
+            ERR_clear_error();
+            throw error("Invalid private key");
+        }
+
+        return cert;
+    }
+
+
     //The constructor.
     context::context(const std::shared_ptr<ssl_ctx_st>& ctx, const char* certificate_file, const char* key_file) 
     : m_ctx(ctx)
@@ -27,6 +140,46 @@ namespace netlib::ssl {
         {
             throw error("Invalid private key");
         }
+
+        //certificates loaded later are set at each handshake
+        certificate_holder* holder = new certificate_holder;
+        if (!SSL_CTX_set_ex_data(ctx.get(), get_certificate_holder_index(), holder)) {
+            delete holder;
+            throw error(ERR_get_error());
+        }
+        SSL_CTX_set_cert_cb(ctx.get(), certificate_callback, nullptr);
+    }
+
+
+    //Checks if kernel TLS is enabled.
+    bool context::kernel_tls() const {
+        #ifdef SSL_OP_ENABLE_KTLS
+        return (SSL_CTX_get_options(m_ctx.get()) & SSL_OP_ENABLE_KTLS) != 0;
+        #else
+        return false;
+        #endif
+    }
+
+
+    //Enables or disables kernel TLS.
+    bool context::set_kernel_tls(bool enabled) {
+        #ifdef SSL_OP_ENABLE_KTLS
+        if (enabled) {
+            SSL_CTX_set_options(m_ctx.get(), SSL_OP_ENABLE_KTLS);
+        }
+        else {
+            SSL_CTX_clear_options(m_ctx.get(), SSL_OP_ENABLE_KTLS);
+        }
+        return true;
+        #else
+        return !enabled;
+        #endif
+    }
+
+
+    //Loads a new certificate and key.
+    void context::load_certificate(const char* certificate_file, const char* key_file) {
+        get_certificate_holder(m_ctx.get()).set(read_certificate(certificate_file, key_file));
     }
 
 
@@ -0,0 +1,165 @@
+#include "platform.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <climits>
+#include "ssl.hpp"
+#include "netlib/ssl_engine.hpp"
+#include "netlib/ssl_error.hpp"
+#include "netlib/numeric_cast.hpp"
+
+
+namespace netlib::ssl {
+
+
+    //converts the result of a non-blocking ssl operation to io status
+    static io_status get_io_status(ssl_io_result result) {
+        switch (result) {
+        case ssl_io_result::failure:
+            return io_status::closed;
+        case ssl_io_result::want_read:
+            return io_status::want_read;
+        case ssl_io_result::want_write:
+            return io_status::want_write;
+        default:
+            return io_status::done;
+        }
+    }
+
+
+    //creates a memory bio that reports 'retry' instead of 'end of file' when empty
+    static BIO* create_memory_bio() {
+        BIO* bio = BIO_new(BIO_s_mem());
+        if (!bio) {
+            throw ssl::error(ERR_get_error());
+        }
+        BIO_set_mem_eof_return(bio, -1);
+        return bio;
+    }
+
+
+    //Constructor.
+    engine::engine(const context& context, role r, const std::string& server_name)
+        : m_ctx(context.ctx())
+        , m_ssl(SSL_new(context.ctx().get()), SSL_free)
+    {
+        if (!m_ssl) {
+            throw ssl::error(ERR_get_error());
+        }
+
+        //create the bios
+        m_input = create_memory_bio();
+        try {
+            m_output = create_memory_bio();
+        }
+        catch (...) {
+            BIO_free(m_input);
+            throw;
+        }
+
+        //the ssl takes ownership of the bios
+        SSL_set_bio(m_ssl.get(), m_input, m_output);
+
+        //set the role
+        if (r == role::server) {
+            SSL_set_accept_state(m_ssl.get());
+            return;
+        }
+        SSL_set_connect_state(m_ssl.get());
+
+        //set the server name
+        if (!server_name.empty() && !SSL_set_tlsext_host_name(m_ssl.get(), server_name.c_str())) {
+            throw ssl::error(ERR_get_error());
+        }
+    }
+
+
+    //Checks if the handshake is complete.
+    bool engine::is_handshake_complete() const {
+        return SSL_is_init_finished(m_ssl.get());
+    }
+
+
+    //Passes encrypted data received by the transport to the engine.
+    void engine::write_input(const char* data, size_t size) {
+        while (size > 0) {
+            const int count = static_cast<int>(std::min(size, static_cast<size_t>(INT_MAX)));
+            const int s = BIO_write(m_input, data, count);
+            if (s <= 0) {
+                throw ssl::error(ERR_get_error());
+            }
+            data += s;
+            size -= static_cast<size_t>(s);
+        }
+    }
+
+
+    //Returns the number of pending encrypted bytes.
+    size_t engine::pending_output_size() const {
+        return BIO_ctrl_pending(m_output);
+    }
+
+
+    //Takes encrypted data produced by the engine.
+    size_t engine::read_output(char* buffer, size_t capacity) {
+        const int count = static_cast<int>(std::min({ capacity, BIO_ctrl_pending(m_output), static_cast<size_t>(INT_MAX) }));
+        if (count == 0) {
+            return 0;
+        }
+        const int s = BIO_read(m_output, buffer, count);
+        return s > 0 ? static_cast<size_t>(s) : 0;
+    }
+
+
+    //Continues the handshake.
+    io_status engine::handshake() {
+        return get_io_status(ssl_handshake(m_ssl.get()));
+    }
+
+
+    //Encrypts data.
+    io_status engine::encrypt(const char* data, size_t size) {
+        //the output bio grows as needed, so the data are encrypted in full once the handshake is complete
+        int sent;
+        return get_io_status(ssl_send_available(m_ssl.get(), data, numeric_cast<int>(size), sent));
+    }
+
+
+    //Decrypts the available input.
+    io_status engine::decrypt(char* buffer, size_t capacity, size_t& size) {
+        if (!buffer || capacity == 0) {
+            throw std::invalid_argument("Empty decryption buffer.");
+        }
+
+        size = 0;
+
+        for (;;) {
+            const int s = SSL_read(m_ssl.get(), buffer, static_cast<int>(std::min(capacity, static_cast<size_t>(INT_MAX))));
+
+            //success
+            if (s > 0) {
+                size = static_cast<size_t>(s);
+                return io_status::done;
+            }
+
+            //closed, or more input is needed
+            const ssl_io_result result = ssl_handle_io_error(m_ssl.get(), s);
+            if (result != ssl_io_result::retry) {
+                return result == ssl_io_result::success ? io_status::want_read : get_io_status(result);
+            }
+        }
+    }
+
+
+    //Returns the number of buffered decrypted bytes.
+    size_t engine::pending_decrypted_size() const {
+        return static_cast<size_t>(SSL_pending(m_ssl.get()));
+    }
+
+
+    //Continues the shutdown.
+    io_status engine::shutdown() {
+        return get_io_status(ssl_shutdown(m_ssl.get()));
+    }
+
+
+} //namespace netlib::ssl
@@ -18,4 +18,16 @@ namespace netlib::ssl {
     }
 
 
+    //Checks if sent data are encrypted by the kernel.
+    bool socket::is_kernel_tls_send_enabled() const {
+        return m_ssl && BIO_get_ktls_send(SSL_get_wbio(m_ssl.get()));
+    }
+
+
+    //Checks if received data are decrypted by the kernel.
+    bool socket::is_kernel_tls_receive_enabled() const {
+        return m_ssl && BIO_get_ktls_recv(SSL_get_rbio(m_ssl.get()));
+    }
+
+
 } //namespace netlib::ssl
@@ -1,22 +1,177 @@
 #include "ssl.hpp"
+#include <map>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <utility>
 #include "netlib/ssl_tcp_client_context.hpp"
+#include "netlib/ssl_error.hpp"
 
 
 namespace netlib::ssl::tcp {
 
 
+    //key of stored sessions: server address and server name
+    using session_key = std::pair<socket_address, std::string>;
+
+
+    //sessions stored by a client context
+    struct session_cache {
+        std::mutex mutex;
+        size_t max_size;
+        std::map<session_key, std::shared_ptr<SSL_SESSION>> sessions;
+
+        //keys in the order they were stored, for removing the oldest sessions
+        std::deque<session_key> keys;
+
+        session_cache(size_t max_size) : max_size(max_size) {
+        }
+
+        //stores a session; takes ownership of the session
+        void store(const session_key& key, SSL_SESSION* session) {
+            std::lock_guard lock(mutex);
+
+            auto [it, inserted] = sessions.insert_or_assign(key, std::shared_ptr<SSL_SESSION>(session, SSL_SESSION_free));
+            if (!inserted) {
+                return;
+            }
+
+            //remove the oldest session
+            keys.push_back(key);
+            if (keys.size() > max_size) {
+                sessions.erase(keys.front());
+                keys.pop_front();
+            }
+        }
+
+        //finds a resumable session
+        std::shared_ptr<SSL_SESSION> find(const session_key& key) {
+            std::lock_guard lock(mutex);
+            auto it = sessions.find(key);
+            return it != sessions.end() && SSL_SESSION_is_resumable(it->second.get()) ? it->second : nullptr;
+        }
+    };
+
+
+    //frees the session cache of an SSL_CTX
+    static void free_session_cache(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+        delete static_cast<session_cache*>(ptr);
+    }
+
+
+    //frees the session key of an SSL
+    static void free_session_key(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+        delete static_cast<session_key*>(ptr);
+    }
+
+
+    //index of the session cache in SSL_CTX ex data
+    static int get_session_cache_index() {
+        static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, free_session_cache);
+        return index;
+    }
+
+
+    //index of the session key in SSL ex data
+    static int get_session_key_index() {
+        static const int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, free_session_key);
+        return index;
+    }
+
+
+    //returns the session cache of an SSL_CTX; null if sessions are not resumed
+    static session_cache* get_session_cache(SSL_CTX* ctx) {
+        return static_cast<session_cache*>(SSL_CTX_get_ex_data(ctx, get_session_cache_index()));
+    }
+
+
+    //invoked by OpenSSL when a new session is established; for TLS 1.3, after the handshake
+    static int new_session_callback(SSL* ssl, SSL_SESSION* session) {
+        session_cache* cache = get_session_cache(SSL_get_SSL_CTX(ssl));
+        const session_key* key = static_cast<const session_key*>(SSL_get_ex_data(ssl, get_session_key_index()));
+        if (!cache || !key) {
+            return 0;
+        }
+        cache->store(*key, session);
+        return 1;
+    }
+
+
     //create context
-    static std::shared_ptr<SSL_CTX> create_context() {
+    static std::shared_ptr<SSL_CTX> create_context(size_t session_cache_size) {
         const SSL_METHOD* method = TLS_client_method();
-        return { SSL_CTX_new(method), SSL_CTX_free };
+        std::shared_ptr<SSL_CTX> ctx{ SSL_CTX_new(method), SSL_CTX_free };
+
+        //store the sessions in the session cache of the context
+        if (session_cache_size > 0) {
+            session_cache* cache = new session_cache(session_cache_size);
+            if (!SSL_CTX_set_ex_data(ctx.get(), get_session_cache_index(), cache)) {
+                delete cache;
+                throw error(ERR_get_error());
+            }
+            SSL_CTX_set_session_cache_mode(ctx.get(), SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+            SSL_CTX_sess_set_new_cb(ctx.get(), new_session_callback);
+        }
+
+        return ctx;
     }
 
 
     //constructor
-    client_context::client_context(const char* certificate_file, const char* key_file)
-        : ssl::context(create_context(), certificate_file, key_file)
+    client_context::client_context(const char* certificate_file, const char* key_file, size_t session_cache_size)
+        : ssl::context(create_context(session_cache_size), certificate_file, key_file)
     {
     }
 
 
+    //Returns the number of stored sessions.
+    size_t client_context::session_count() const {
+        session_cache* cache = get_session_cache(ctx().get());
+        if (!cache) {
+            return 0;
+        }
+        std::lock_guard lock(cache->mutex);
+        return cache->sessions.size();
+    }
+
+
+    //Removes the stored sessions.
+    void client_context::clear_sessions() {
+        session_cache* cache = get_session_cache(ctx().get());
+        if (!cache) {
+            return;
+        }
+        std::lock_guard lock(cache->mutex);
+        cache->sessions.clear();
+        cache->keys.clear();
+    }
+
+
 } //namespace netlib::ssl::tcp
+
+
+namespace netlib::ssl {
+
+
+    //Prepares the ssl for resuming the session stored for the given server.
+    void ssl_resume_session(SSL* ssl, const socket_address& server_addr, const std::string& server_name) {
+        tcp::session_cache* cache = tcp::get_session_cache(SSL_get_SSL_CTX(ssl));
+        if (!cache) {
+            return;
+        }
+
+        //new sessions are stored under the server address and name
+        tcp::session_key* key = new tcp::session_key(server_addr, server_name);
+        if (!SSL_set_ex_data(ssl, tcp::get_session_key_index(), key)) {
+            delete key;
+            throw error(ERR_get_error());
+        }
+
+        //resume the stored session
+        if (std::shared_ptr<SSL_SESSION> session = cache->find(*key)) {
+            SSL_set_session(ssl, session.get());
+        }
+    }
+
+
+} //namespace netlib::ssl
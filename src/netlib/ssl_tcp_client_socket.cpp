@@ -1,46 +1,94 @@
 #include "platform.hpp"
+#include <stdexcept>
 #include <system_error>
+#include <cstring>
+#include <algorithm>
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
 #include "ssl.hpp"
 #include "netlib/ssl_tcp_client_socket.hpp"
 #include "netlib/numeric_cast.hpp"
 #include "netlib/ssl_error.hpp"
 #include "netlib/message_size_t.hpp"
 #include "netlib/endianess.hpp"
+#include "tcp_connect.hpp"
 
 
 namespace netlib::ssl::tcp {
 
 
     //create the socket and the ssl
-    static std::shared_ptr<SSL> create_ssl(const client_context& context, const std::optional<socket_address>& this_addr, const socket_address& server_addr, bool reuse_address_and_port) {
+    static std::shared_ptr<SSL> create_ssl(const client_context& context, const std::optional<socket_address>& this_addr, const socket_address& server_addr, const std::string& server_name, bool reuse_address_and_port, bool non_blocking, const socket_options& options) {
         //create the socket
         socket::handle_type sock = ::socket(server_addr.address_family(), SOCK_STREAM, IPPROTO_TCP);
 
         //failure to create the socket
-        if (sock < 0) {
+        if (sock == socket::invalid_handle) {
             throw std::system_error(get_last_error_number(), std::system_category());
         }
 
-        //set reuse
-        if (reuse_address_and_port) {
-            socket::set_reuse_address_and_port(sock);
-        }
+        //writing to a socket closed by the peer shall not raise SIGPIPE
+        set_socket_no_sigpipe(sock);
 
-        //optionally bind the socket
-        if (this_addr.has_value() && ::bind(sock, reinterpret_cast<const sockaddr*>(this_addr.value().data()), sizeof(sockaddr_storage))) {
-            throw std::system_error(get_last_error_number(), std::system_category());
+        std::shared_ptr<SSL> ssl;
+
+        //until the ssl owns the socket, close the socket on failure
+        try {
+            //set reuse
+            if (reuse_address_and_port) {
+                socket::set_reuse_address_and_port(sock);
+            }
+
+            //set the options before connecting, since some of them affect the connection setup
+            socket::set_options(sock, options);
+
+            //optionally bind the socket
+            if (this_addr.has_value() && ::bind(sock, reinterpret_cast<const sockaddr*>(this_addr.value().data()), sizeof(sockaddr_storage))) {
+                throw std::system_error(get_last_error_number(), std::system_category());
+            }
+
+            //make the socket non-blocking before connecting, so as that the connection is not waited for
+            if (non_blocking && set_socket_non_blocking(sock, true)) {
+                throw std::system_error(get_last_error_number(), std::system_category());
+            }
+
+            //connect to the server; if error, throw exception
+            if (::connect(sock, reinterpret_cast<const sockaddr*>(server_addr.data()), sizeof(sockaddr_storage)) && !(non_blocking && is_operation_in_progress_error(get_last_error_number()))) {
+                throw std::system_error(get_last_error_number(), std::system_category());
+            }
+
+            //crreate the ssl
+            SSL* new_ssl = SSL_new(context.ctx().get());
+            if (!new_ssl) {
+                throw ssl::error(ERR_get_error());
+            }
+            ssl = std::shared_ptr<SSL>(new_ssl, SSL_close);
+
+            //connect the ssl and the socket; from now on, the ssl closes the socket
+            if (SSL_set_fd(ssl.get(), numeric_cast<int>(sock)) != 1) {
+                throw ssl::error(ERR_get_error());
+            }
+        }
+        catch (...) {
+            closesocket(sock);
+            throw;
         }
 
-        //connect to the server; if error, throw exception
-        if (::connect(sock, reinterpret_cast<const sockaddr*>(server_addr.data()), sizeof(sockaddr_storage))) {
-            throw std::system_error(get_last_error_number(), std::system_category());
+        //set the server name
+        if (!server_name.empty() && !SSL_set_tlsext_host_name(ssl.get(), server_name.c_str())) {
+            throw ssl::error(ERR_get_error());
         }
 
-        //crreate the ssl
-        std::shared_ptr<SSL> ssl{SSL_new(context.ctx().get()), SSL_close};
+        //resume the session of a previous connection to the server
+        ssl_resume_session(ssl.get(), server_addr, server_name);
 
-        //connect the ssl and the socket
-        SSL_set_fd(ssl.get(), numeric_cast<int>(sock));
+        //non-blocking socket; the handshake is done by handshake()
+        if (non_blocking) {
+            SSL_set_mode(ssl.get(), SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+            SSL_set_connect_state(ssl.get());
+            return ssl;
+        }
 
         //connect the SLL part
         if (SSL_connect(ssl.get()) != 1) {
@@ -52,41 +100,474 @@ namespace netlib::ssl::tcp {
     }
 
 
+    //connects the socket and does the handshake in non-blocking mode, until the timeout expires;
+    //the socket is blocking on success
+    static std::shared_ptr<SSL> create_ssl(const client_context& context, const std::vector<socket_address>& server_addrs, const std::optional<socket_address>& this_addr, bool reuse_address_and_port, const socket_options& options, const std::string& server_name, std::chrono::milliseconds timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        //connect the socket
+        const socket::handle_type sock = tcp_connect(server_addrs, this_addr, reuse_address_and_port, options, deadline);
+
+        //create the ssl
+        SSL* ssl_ptr = SSL_new(context.ctx().get());
+        if (!ssl_ptr) {
+            closesocket(sock);
+            throw ssl::error(ERR_get_error());
+        }
+
+        //the ssl owns the socket from now on
+        std::shared_ptr<SSL> ssl{ssl_ptr, SSL_close};
+        SSL_set_fd(ssl.get(), numeric_cast<int>(sock));
+
+        //set the server name
+        if (!server_name.empty() && !SSL_set_tlsext_host_name(ssl.get(), server_name.c_str())) {
+            throw ssl::error(ERR_get_error());
+        }
+
+        //resume the session of a previous connection to the server
+        ssl_resume_session(ssl.get(), socket::peer_address(sock), server_name);
+
+        //do the handshake, waiting for the socket until the deadline
+        SSL_set_connect_state(ssl.get());
+        for (;;) {
+            switch (ssl_handshake(ssl.get())) {
+            case ssl_io_result::want_read:
+                wait_socket(sock, POLLIN, deadline);
+                continue;
+            case ssl_io_result::want_write:
+                wait_socket(sock, POLLOUT, deadline);
+                continue;
+            case ssl_io_result::failure:
+                throw ssl::error("Connection closed during the handshake.");
+            default:
+                break;
+            }
+            break;
+        }
+
+        //the socket is blocking after the connection
+        if (set_socket_non_blocking(sock, false)) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+
+        return ssl;
+    }
+
+
+    //checks if a hostname is an ip address string, which is not sent as server name
+    static bool is_ip_address_string(const std::string& hostname) {
+        char buffer[16];
+        const std::string ip6_str = hostname.substr(0, hostname.find('%'));
+        return inet_pton(AF_INET, hostname.c_str(), buffer) == 1 || inet_pton(AF_INET6, ip6_str.c_str(), buffer) == 1;
+    }
+
+
+    //checks if the connection of a non-blocking socket is established; throws if the connection failed
+    static bool is_connected(socket::handle_type handle) {
+        pollfd pfd{};
+        pfd.fd = handle;
+        pfd.events = POLLOUT;
+
+        //check if the socket is writable
+        const int r = ::poll(&pfd, 1, 0);
+        if (r < 0) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+        if (r == 0) {
+            return false;
+        }
+
+        //get the result of the connection
+        int error = 0;
+        socklen_t error_size = sizeof(error);
+        if (getsockopt(handle, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &error_size)) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+        if (error) {
+            throw std::system_error(error, std::system_category());
+        }
+
+        return true;
+    }
+
+
+    //converts the result of a non-blocking ssl operation to io status
+    static io_status get_io_status(ssl_io_result result) {
+        switch (result) {
+        case ssl_io_result::failure:
+            return io_status::closed;
+        case ssl_io_result::want_read:
+            return io_status::want_read;
+        case ssl_io_result::want_write:
+            return io_status::want_write;
+        default:
+            return io_status::done;
+        }
+    }
+
+
     //constructor
-    client_socket::client_socket(const client_context& context, const std::optional<socket_address>& this_addr, const socket_address& server_addr, bool reuse_address_and_port)
-        : ssl::socket(context.ctx(), create_ssl(context, this_addr, server_addr, reuse_address_and_port))
+    client_socket::client_socket(const client_context& context, const std::optional<socket_address>& this_addr, const socket_address& server_addr, bool reuse_address_and_port, bool non_blocking, const socket_options& options)
+        : ssl::socket(context.ctx(), create_ssl(context, this_addr, server_addr, {}, reuse_address_and_port, non_blocking, options))
+        , m_connecting(non_blocking)
+    {
+    }
+
+
+    //constructor with server name
+    client_socket::client_socket(const client_context& context, const std::optional<socket_address>& this_addr, const socket_address& server_addr, const std::string& server_name, bool reuse_address_and_port, bool non_blocking, const socket_options& options)
+        : ssl::socket(context.ctx(), create_ssl(context, this_addr, server_addr, server_name, reuse_address_and_port, non_blocking, options))
+        , m_connecting(non_blocking)
+    {
+    }
+
+
+    //constructor with connection timeout
+    client_socket::client_socket(const client_context& context, const std::optional<socket_address>& this_addr, const socket_address& server_addr, std::chrono::milliseconds timeout, const std::string& server_name, bool reuse_address_and_port, const socket_options& options)
+        : ssl::socket(context.ctx(), create_ssl(context, { server_addr }, this_addr, reuse_address_and_port, options, server_name, timeout))
+    {
+    }
+
+
+    //constructor from hostname, with connection timeout
+    client_socket::client_socket(const client_context& context, const std::string& hostname, uint16_t port, std::chrono::milliseconds timeout, const socket_options& options)
+        : ssl::socket(context.ctx(), create_ssl(context, get_connection_addresses(hostname, port), std::nullopt, false, options, is_ip_address_string(hostname) ? std::string() : hostname, timeout))
     {
     }
 
 
+    //Checks if the session was resumed.
+    bool client_socket::is_session_reused() const {
+        return ssl() && SSL_session_reused(ssl().get());
+    }
+
+
+    //size of the plaintext of a full tls record
+    static constexpr size_t record_size = SSL3_RT_MAX_PLAIN_LENGTH;
+
+
+    //packs data into full tls records, so as that small writes do not produce a record each
+    class record_writer {
+    public:
+        //the buffer is used as storage for a partial record; its memory is kept between uses
+        record_writer(SSL* ssl, std::vector<char>& buffer) : m_ssl(ssl), m_buffer(buffer) {
+            m_buffer.clear();
+            m_buffer.reserve(record_size);
+        }
+
+        //adds data; full records are sent
+        bool write(const char* d, size_t len) {
+            while (len > 0) {
+                //no partial record; whole records are sent directly from the data
+                if (m_buffer.empty() && len >= record_size) {
+                    const size_t count = len - len % record_size;
+                    if (!ssl_send(m_ssl, d, numeric_cast<int>(count))) {
+                        return false;
+                    }
+                    d += count;
+                    len -= count;
+                    continue;
+                }
+
+                //complete the partial record
+                const size_t count = std::min(len, record_size - m_buffer.size());
+                m_buffer.insert(m_buffer.end(), d, d + count);
+                d += count;
+                len -= count;
+
+                //send the record when full
+                if (m_buffer.size() == record_size && !flush()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        //sends the partial record
+        bool flush() {
+            if (m_buffer.empty()) {
+                return true;
+            }
+            const bool result = ssl_send(m_ssl, m_buffer.data(), numeric_cast<int>(m_buffer.size()));
+            m_buffer.clear();
+            return result;
+        }
+
+    private:
+        SSL* m_ssl;
+        std::vector<char>& m_buffer;
+    };
+
+
     //Sends data to the server.
     bool client_socket::send(const std::vector<char>& data) {
-        message_size_t size = numeric_cast<message_size_t>(data.size());
+        return send(data.data(), data.size());
+    }
+
+
+    //Sends data to the server.
+    bool client_socket::send(const char* data, size_t size) {
+        message_size_t message_size = numeric_cast<message_size_t>(size);
+        set_endianess(message_size);
+
+        //the size is sent in the same record as the data
+        record_writer writer(ssl().get(), m_record_buffer);
+        return writer.write(reinterpret_cast<const char*>(&message_size), sizeof(message_size)) && writer.write(data, size) && writer.flush();
+    }
+
+
+    //Sends multiple messages to the server.
+    bool client_socket::send_batch(const std::vector<std::vector<char>>& messages) {
+        record_writer writer(ssl().get(), m_record_buffer);
+
+        for (const std::vector<char>& data : messages) {
+            message_size_t size = numeric_cast<message_size_t>(data.size());
+            set_endianess(size);
+            if (!writer.write(reinterpret_cast<const char*>(&size), sizeof(size)) || !writer.write(data.data(), data.size())) {
+                return false;
+            }
+        }
+
+        return writer.flush();
+    }
+
+
+    #ifndef _WIN32
+    //Sends the contents of a file to the server.
+    bool client_socket::send_file(int file, uint64_t offset, size_t size) {
+        //check the range before anything is sent, so as that the message is not left incomplete
+        struct stat file_status;
+        if (::fstat(file, &file_status)) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+        if (offset > static_cast<uint64_t>(file_status.st_size) || size > static_cast<uint64_t>(file_status.st_size) - offset) {
+            throw std::invalid_argument("The file does not contain the given range.");
+        }
+
+        message_size_t message_size = numeric_cast<message_size_t>(size);
 
         //send size
-        set_endianess(size);
-        if (!ssl_send(ssl().get(), reinterpret_cast<const char*>(&size), sizeof(size))) {
+        set_endianess(message_size);
+        if (!ssl_send(ssl().get(), reinterpret_cast<const char*>(&message_size), sizeof(message_size))) {
             return false;
         }
 
-        //send data
-        return ssl_send(ssl().get(), data.data(), numeric_cast<int>(data.size()));
+        #if OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(OPENSSL_NO_KTLS)
+        //the kernel encrypts the file data
+        if (is_kernel_tls_send_enabled()) {
+            while (size > 0) {
+                const ossl_ssize_t s = SSL_sendfile(ssl().get(), file, static_cast<off_t>(offset), size, 0);
+
+                //success
+                if (s > 0) {
+                    offset += static_cast<uint64_t>(s);
+                    size -= static_cast<size_t>(s);
+                    continue;
+                }
+
+                switch (ssl_handle_io_error(ssl().get(), static_cast<int>(s))) {
+                case ssl_io_result::failure:
+                    return false;
+                case ssl_io_result::want_read:
+                case ssl_io_result::want_write:
+                    throw std::logic_error("Blocking SSL I/O on a non-blocking socket.");
+                default:
+                    break;
+                }
+            }
+            return true;
+        }
+        #endif
+
+        //read the file data, then send them through the ssl layer
+        char buffer[16384];
+        while (size > 0) {
+            const ssize_t s = ::pread(file, buffer, std::min(size, sizeof(buffer)), static_cast<off_t>(offset));
+            if (s <= 0) {
+                throw std::system_error(s < 0 ? get_last_error_number() : EIO, std::system_category());
+            }
+            if (!ssl_send(ssl().get(), buffer, static_cast<int>(s))) {
+                return false;
+            }
+            offset += static_cast<uint64_t>(s);
+            size -= static_cast<size_t>(s);
+        }
+
+        return true;
     }
+    #endif
 
 
     //Receives data from the server.
     bool client_socket::receive(std::vector<char>& data) {
+        const auto receive_available = [&](char* d, size_t len) {
+            return ssl_receive_available(ssl().get(), d, numeric_cast<int>(len));
+        };
+
         message_size_t size;
 
+        //receive size; the following messages might be received together with it
+        if (!m_receive_buffer.read(reinterpret_cast<char*>(&size), sizeof(size), receive_available)) {
+            return false;
+        }
+        set_endianess(size);
+
+        //receive data
+        data.resize(size);
+        return m_receive_buffer.read(data.data(), size, receive_available);
+    }
+
+
+    //Receives data from the server into the given buffer.
+    bool client_socket::receive(char* buffer, size_t capacity, size_t& size) {
+        const auto receive_available = [&](char* d, size_t len) {
+            return ssl_receive_available(ssl().get(), d, numeric_cast<int>(len));
+        };
+
+        message_size_t message_size;
+
         //receive size
-        if (!ssl_receive(ssl().get(), reinterpret_cast<char*>(&size), sizeof(size))) {
+        if (!m_receive_buffer.read(reinterpret_cast<char*>(&message_size), sizeof(message_size), receive_available)) {
+            return false;
+        }
+        set_endianess(message_size);
+
+        //if the message does not fit, discard it, so as that the next message can be received
+        if (message_size > capacity) {
+            if (!m_receive_buffer.skip(message_size, receive_available)) {
+                return false;
+            }
+            throw std::length_error("Message does not fit in the buffer.");
+        }
+
+        //receive data
+        size = message_size;
+        return m_receive_buffer.read(buffer, message_size, receive_available);
+    }
+
+
+    //Receives data from the server into a message buffer.
+    bool client_socket::receive(message_buffer& data) {
+        const auto receive_available = [&](char* d, size_t len) {
+            return ssl_receive_available(ssl().get(), d, numeric_cast<int>(len));
+        };
+
+        message_size_t size;
+
+        //receive size
+        if (!m_receive_buffer.read(reinterpret_cast<char*>(&size), sizeof(size), receive_available)) {
             return false;
         }
         set_endianess(size);
 
         //receive data
+        data.reserve(size);
         data.resize(size);
-        return ssl_receive(ssl().get(), data.data(), numeric_cast<int>(size));
+        return m_receive_buffer.read(data.data(), size, receive_available);
+    }
+
+
+    //Continues the ssl handshake of a non-blocking socket.
+    io_status client_socket::handshake() {
+        //wait for the connection to be established
+        if (m_connecting) {
+            if (!is_connected(handle())) {
+                return io_status::want_write;
+            }
+            m_connecting = false;
+        }
+
+        return get_io_status(ssl_handshake(ssl().get()));
+    }
+
+
+    //Sends data to the other side over a non-blocking socket.
+    io_status client_socket::send_non_blocking(const std::vector<char>& data) {
+        message_size_t size = numeric_cast<message_size_t>(data.size());
+        set_endianess(size);
+
+        //queue the message
+        m_send_buffer.insert(m_send_buffer.end(), reinterpret_cast<const char*>(&size), reinterpret_cast<const char*>(&size) + sizeof(size));
+        m_send_buffer.insert(m_send_buffer.end(), data.begin(), data.end());
+
+        return flush();
+    }
+
+
+    //Sends the queued data of a non-blocking socket.
+    io_status client_socket::flush() {
+        if (m_sent_size == m_send_buffer.size()) {
+            return io_status::done;
+        }
+
+        //send as much as possible
+        int sent;
+        const ssl_io_result result = ssl_send_available(ssl().get(), m_send_buffer.data() + m_sent_size, numeric_cast<int>(m_send_buffer.size() - m_sent_size), sent);
+        m_sent_size += static_cast<size_t>(sent);
+
+        //all data are sent
+        if (m_sent_size == m_send_buffer.size()) {
+            m_send_buffer.clear();
+            m_sent_size = 0;
+            return io_status::done;
+        }
+
+        return result == ssl_io_result::success ? io_status::want_write : get_io_status(result);
+    }
+
+
+    //Receives data from the other side over a non-blocking socket.
+    io_status client_socket::receive_non_blocking(std::vector<char>& data) {
+        ssl_io_result result = ssl_io_result::success;
+
+        const auto receive_available = [&](char* d, size_t len) {
+            for (;;) {
+                const int s = SSL_read(ssl().get(), d, numeric_cast<int>(len));
+                if (s > 0) {
+                    return s;
+                }
+                result = ssl_handle_io_error(ssl().get(), s);
+                if (result != ssl_io_result::retry) {
+                    return 0;
+                }
+            }
+        };
+
+        for (;;) {
+            size_t message_size = sizeof(message_size_t);
+
+            //if the size of the message is buffered, the whole message is required
+            if (m_receive_buffer.size() >= sizeof(message_size_t)) {
+                message_size_t size;
+                std::memcpy(&size, m_receive_buffer.data(), sizeof(size));
+                set_endianess(size);
+                message_size += size;
+
+                //the whole message is buffered
+                if (m_receive_buffer.size() >= message_size) {
+                    data.assign(m_receive_buffer.data() + sizeof(size), m_receive_buffer.data() + message_size);
+                    m_receive_buffer.consume(message_size);
+                    return io_status::done;
+                }
+            }
+
+            //receive the available data
+            if (m_receive_buffer.fill(message_size, receive_available) <= 0) {
+                return result == ssl_io_result::success ? io_status::want_read : get_io_status(result);
+            }
+        }
+    }
+
+
+    //Continues the ssl shutdown of a non-blocking socket.
+    io_status client_socket::shutdown() {
+        return get_io_status(ssl_shutdown(ssl().get()));
+    }
+
+
+    //Returns the number of received bytes that are buffered.
+    size_t client_socket::buffered_receive_size() const {
+        return m_receive_buffer.size() + (ssl() ? SSL_pending(ssl().get()) : 0);
     }
 
 
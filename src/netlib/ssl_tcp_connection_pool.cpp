@@ -0,0 +1,72 @@
+#include "platform.hpp"
+#include <system_error>
+#include "ssl.hpp"
+#include "netlib/ssl_tcp_connection_pool.hpp"
+
+
+namespace netlib::ssl::tcp {
+
+
+    //Constructor.
+    connection_pool::connection_pool(const connection_pool_options& options) : netlib::connection_pool(options) {
+    }
+
+
+    //Returns a connection to the given server.
+    std::shared_ptr<client_socket> connection_pool::acquire(const client_context& context, const socket_address& server_addr, const std::string& server_name) {
+        const key k{ server_addr, context.ctx(), server_name };
+        const auto deadline = std::chrono::steady_clock::now() + options().connect_timeout;
+
+        //reuse an idle connection
+        std::unique_ptr<netlib::socket> s = checkout(k, deadline);
+        if (s) {
+            return hand_out(k, std::unique_ptr<client_socket>(static_cast<client_socket*>(s.release())));
+        }
+
+        //else create a new connection
+        std::unique_ptr<client_socket> cs;
+        try {
+            cs = std::make_unique<client_socket>(context, std::nullopt, server_addr, get_remaining_time(deadline), server_name, false, options().connection_options);
+        }
+        catch (...) {
+            cancel(k);
+            throw;
+        }
+        return hand_out(k, std::move(cs));
+    }
+
+
+    //Checks if an idle connection can be reused.
+    bool connection_pool::is_healthy(netlib::socket& s) const {
+        client_socket& cs = static_cast<client_socket&>(s);
+        SSL* ssl = cs.ssl().get();
+
+        if (cs.buffered_receive_size() > 0) {
+            return false;
+        }
+
+        //not readable; healthy
+        pollfd pfd{};
+        pfd.fd = cs.handle();
+        pfd.events = POLLIN;
+        if (poll(&pfd, 1, 0) == 0) {
+            return true;
+        }
+
+        //readable; process the pending records without waiting;
+        //the connection is healthy if they carry no application data and no close notification
+        if (set_socket_non_blocking(cs.handle(), true)) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+        char c;
+        const int r = SSL_peek(ssl, &c, 1);
+        const bool result = r <= 0 && SSL_get_error(ssl, r) == SSL_ERROR_WANT_READ;
+        ERR_clear_error();
+        if (set_socket_non_blocking(cs.handle(), false)) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+        return result;
+    }
+
+
+} //namespace netlib::ssl::tcp
@@ -0,0 +1,211 @@
+#include "platform.hpp"
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+#include "netlib/ssl_tcp_handshake_pipeline.hpp"
+
+
+namespace netlib::ssl::tcp {
+
+
+    //Constructor.
+    handshake_pipeline::handshake_pipeline(const std::shared_ptr<server_socket>& server, const completion_callback_type& on_complete, const error_callback_type& on_error, size_t thread_count, std::chrono::milliseconds timeout)
+        : m_server(server)
+        , m_on_complete(on_complete)
+        , m_on_error(on_error)
+        , m_timeout(timeout)
+        , m_stop(false)
+        , m_pollers(thread_count)
+    {
+        //check the parameters
+        if (!server) {
+            throw std::invalid_argument("Invalid server socket.");
+        }
+        if (!on_complete) {
+            throw std::invalid_argument("Invalid completion callback.");
+        }
+
+        //accept connections
+        if (!m_pollers.add(std::static_pointer_cast<netlib::socket>(server), [this](socket_poller&, const socket_poller::socket_ptr&, socket_poller::event_type, socket_poller::status_flags) {
+            accept();
+            })) {
+            throw std::runtime_error("Socket poller is full.");
+        }
+
+        //start the timeout thread; it is started last, since it must be joined if the constructor fails
+        m_timeout_thread = std::thread([this]() { run_timeouts(); });
+    }
+
+
+    //Stops the pipeline.
+    handshake_pipeline::~handshake_pipeline() {
+        stop();
+    }
+
+
+    //Returns the number of handshakes in progress.
+    size_t handshake_pipeline::pending_handshake_count() const {
+        std::lock_guard lock(m_mutex);
+        return m_handshakes.size();
+    }
+
+
+    //Stops accepting connections, and drops the handshakes in progress.
+    void handshake_pipeline::stop() {
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_stop) {
+                return;
+            }
+            m_stop = true;
+        }
+
+        m_stop_cond.notify_one();
+        m_timeout_thread.join();
+        m_pollers.stop();
+
+        std::lock_guard lock(m_mutex);
+        m_handshakes.clear();
+    }
+
+
+    //accepts a connection
+    void handshake_pipeline::accept() {
+        socket_address addr;
+        client_socket_ptr s;
+
+        //accept without doing the handshake
+        try {
+            s = m_server->accept(addr, true);
+        }
+        catch (...) {
+            report_error(addr, std::current_exception());
+            return;
+        }
+
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_stop) {
+                return;
+            }
+            m_handshakes.emplace(s.get(), handshake{ s, addr, std::chrono::steady_clock::now() + m_timeout, true });
+        }
+
+        continue_handshake(s);
+    }
+
+
+    //invoked when a socket is ready for the next handshake step
+    void handshake_pipeline::on_socket_ready(const client_socket_ptr& s) {
+        {
+            std::lock_guard lock(m_mutex);
+
+            //the handshake was dropped, or another thread does the step
+            auto it = m_handshakes.find(s.get());
+            if (it == m_handshakes.end() || it->second.in_progress) {
+                return;
+            }
+
+            it->second.in_progress = true;
+            m_pollers.remove(s);
+        }
+
+        continue_handshake(s);
+    }
+
+
+    //does a handshake step
+    void handshake_pipeline::continue_handshake(const client_socket_ptr& s) {
+        io_status status = io_status::closed;
+        std::exception_ptr error;
+
+        //handshake step
+        try {
+            status = s->handshake();
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        std::unique_lock lock(m_mutex);
+
+        auto it = m_handshakes.find(s.get());
+        if (it == m_handshakes.end()) {
+            return;
+        }
+        const socket_address addr = it->second.address;
+
+        //wait for the socket to be ready for the next step
+        if (!error && !m_stop && (status == io_status::want_read || status == io_status::want_write)) {
+            it->second.in_progress = false;
+            const socket_poller::event_type event = status == io_status::want_read ? socket_poller::event_type::read : socket_poller::event_type::write;
+            if (m_pollers.add(std::static_pointer_cast<netlib::socket>(s), event, [this](socket_poller&, const socket_poller::socket_ptr& s, socket_poller::event_type, socket_poller::status_flags) {
+                on_socket_ready(std::static_pointer_cast<client_socket>(s));
+                }, socket_poller::registration_mode::one_shot))
+            {
+                return;
+            }
+            error = std::make_exception_ptr(std::runtime_error("Socket poller full."));
+        }
+
+        m_handshakes.erase(it);
+        lock.unlock();
+
+        //handshake complete
+        if (!error && status == io_status::done) {
+            m_on_complete(s, addr);
+            return;
+        }
+
+        //handshake failed
+        if (!error && status == io_status::closed) {
+            error = std::make_exception_ptr(std::runtime_error("Connection closed during the handshake."));
+        }
+        if (error) {
+            report_error(addr, error);
+        }
+    }
+
+
+    //drops the handshakes that timed out
+    void handshake_pipeline::run_timeouts() {
+        const std::chrono::milliseconds interval = std::max(m_timeout / 4, std::chrono::milliseconds(1));
+        std::vector<socket_address> expired;
+
+        std::unique_lock lock(m_mutex);
+
+        while (!m_stop_cond.wait_for(lock, interval, [this]() { return m_stop; })) {
+            //drop the expired handshakes that wait for a poller event
+            const auto now = std::chrono::steady_clock::now();
+            for (auto it = m_handshakes.begin(); it != m_handshakes.end();) {
+                if (it->second.in_progress || it->second.deadline > now) {
+                    ++it;
+                    continue;
+                }
+                m_pollers.remove(it->second.socket);
+                expired.push_back(it->second.address);
+                it = m_handshakes.erase(it);
+            }
+
+            //report the timeouts
+            if (!expired.empty()) {
+                lock.unlock();
+                for (const socket_address& addr : expired) {
+                    report_error(addr, std::make_exception_ptr(std::system_error(get_connection_timeout_error_number(), std::system_category())));
+                }
+                expired.clear();
+                lock.lock();
+            }
+        }
+    }
+
+
+    //invokes the error callback
+    void handshake_pipeline::report_error(const socket_address& addr, const std::exception_ptr& error) {
+        if (m_on_error) {
+            m_on_error(addr, error);
+        }
+    }
+
+
+} //namespace netlib::ssl::tcp
@@ -1,14 +1,172 @@
 #include "ssl.hpp"
+#include <deque>
+#include <mutex>
+#include <cstring>
+#include "openssl/rand.h"
+#include "openssl/evp.h"
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include "openssl/core_names.h"
+#else
+#include "openssl/hmac.h"
+#endif
 #include "netlib/ssl_tcp_server_context.hpp"
+#include "netlib/ssl_error.hpp"
 
 
 namespace netlib::ssl::tcp {
 
 
+    //session ticket key
+    struct ticket_key {
+        unsigned char name[16];
+        unsigned char aes_key[32];
+        unsigned char hmac_key[32];
+    };
+
+
+    //session ticket keys of a server context
+    struct ticket_keys {
+        std::mutex mutex;
+
+        //the first key is the current key, the second key is the previous key
+        std::deque<ticket_key> keys;
+
+        //time the current key was created
+        std::chrono::steady_clock::time_point creation_time;
+
+        //rotation interval
+        std::chrono::seconds rotation_interval{ NETLIB_SSL_TICKET_KEY_ROTATION_INTERVAL };
+
+        //creates a new current key, keeping the previous one
+        void rotate() {
+            ticket_key key;
+            if (RAND_bytes(key.name, sizeof(key.name)) <= 0 || RAND_bytes(key.aes_key, sizeof(key.aes_key)) <= 0 || RAND_bytes(key.hmac_key, sizeof(key.hmac_key)) <= 0) {
+                throw error(ERR_get_error());
+            }
+            keys.push_front(key);
+            if (keys.size() > 2) {
+                keys.pop_back();
+            }
+            creation_time = std::chrono::steady_clock::now();
+        }
+
+        //rotates the keys, if the current key is older than the rotation interval
+        void rotate_if_expired() {
+            if (rotation_interval.count() > 0 && std::chrono::steady_clock::now() - creation_time >= rotation_interval) {
+                rotate();
+            }
+        }
+    };
+
+
+    //frees the ticket keys of an SSL_CTX
+    static void free_ticket_keys(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+        delete static_cast<ticket_keys*>(ptr);
+    }
+
+
+    //index of the ticket keys in SSL_CTX ex data
+    static int get_ticket_keys_index() {
+        static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, free_ticket_keys);
+        return index;
+    }
+
+
+    //returns the ticket keys of an SSL_CTX
+    static ticket_keys& get_ticket_keys(SSL_CTX* ctx) {
+        return *static_cast<ticket_keys*>(SSL_CTX_get_ex_data(ctx, get_ticket_keys_index()));
+    }
+
+
+    #if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    using ticket_mac_ctx = EVP_MAC_CTX;
+
+    //sets the hmac key
+    static bool init_ticket_mac(EVP_MAC_CTX* mac_ctx, unsigned char* hmac_key) {
+        OSSL_PARAM params[] = {
+            OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, hmac_key, 32),
+            OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char*>("SHA256"), 0),
+            OSSL_PARAM_construct_end()
+        };
+        return EVP_MAC_CTX_set_params(mac_ctx, params) == 1;
+    }
+    #else
+    using ticket_mac_ctx = HMAC_CTX;
+
+    //sets the hmac key
+    static bool init_ticket_mac(HMAC_CTX* mac_ctx, unsigned char* hmac_key) {
+        return HMAC_Init_ex(mac_ctx, hmac_key, 32, EVP_sha256(), nullptr) == 1;
+    }
+    #endif
+
+
+    //invoked by OpenSSL for encrypting and decrypting session tickets
+    static int ticket_key_callback(SSL* ssl, unsigned char* key_name, unsigned char* iv, EVP_CIPHER_CTX* cipher_ctx, ticket_mac_ctx* mac_ctx, int encrypt) {
+        ticket_keys& keys = get_ticket_keys(SSL_get_SSL_CTX(ssl));
+        std::lock_guard lock(keys.mutex);
+
+        //encrypt with the current key
+        if (encrypt) {
+            try {
+                keys.rotate_if_expired();
+            }
+            catch (const error&) {
+                return -1;
+            }
+            ticket_key& key = keys.keys.front();
+            if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) <= 0) {
+                return -1;
+            }
+            std::memcpy(key_name, key.name, sizeof(key.name));
+            if (!EVP_EncryptInit_ex(cipher_ctx, EVP_aes_256_cbc(), nullptr, key.aes_key, iv) || !init_ticket_mac(mac_ctx, key.hmac_key)) {
+                return -1;
+            }
+            return 1;
+        }
+
+        //decrypt with the key of the ticket
+        for (size_t i = 0; i < keys.keys.size(); ++i) {
+            ticket_key& key = keys.keys[i];
+            if (std::memcmp(key_name, key.name, sizeof(key.name)) == 0) {
+                if (!EVP_DecryptInit_ex(cipher_ctx, EVP_aes_256_cbc(), nullptr, key.aes_key, iv) || !init_ticket_mac(mac_ctx, key.hmac_key)) {
+                    return -1;
+                }
+
+                //renew tickets encrypted with the previous key
+                return i == 0 ? 1 : 2;
+            }
+        }
+
+        //unknown key; full handshake
+        return 0;
+    }
+
+
     //create context
     static std::shared_ptr<SSL_CTX> create_context() {
         const SSL_METHOD* method = TLS_server_method();
-        return {SSL_CTX_new(method), SSL_CTX_free};
+        std::shared_ptr<SSL_CTX> ctx{SSL_CTX_new(method), SSL_CTX_free};
+
+        //session cache
+        static const unsigned char session_id_context[] = "netlib";
+        SSL_CTX_set_session_id_context(ctx.get(), session_id_context, sizeof(session_id_context) - 1);
+        SSL_CTX_set_session_cache_mode(ctx.get(), SSL_SESS_CACHE_SERVER);
+        SSL_CTX_sess_set_cache_size(ctx.get(), NETLIB_SSL_SERVER_SESSION_CACHE_SIZE);
+
+        //session tickets
+        ticket_keys* keys = new ticket_keys;
+        if (!SSL_CTX_set_ex_data(ctx.get(), get_ticket_keys_index(), keys)) {
+            delete keys;
+            throw error(ERR_get_error());
+        }
+        keys->rotate();
+        #if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx.get(), ticket_key_callback);
+        #else
+        SSL_CTX_set_tlsext_ticket_key_cb(ctx.get(), ticket_key_callback);
+        #endif
+
+        return ctx;
     }
 
 
@@ -19,4 +177,53 @@ namespace netlib::ssl::tcp {
     }
 
 
+    //Returns the max number of sessions stored in the session cache.
+    size_t server_context::session_cache_size() const {
+        return SSL_CTX_get_session_cache_mode(ctx().get()) & SSL_SESS_CACHE_SERVER ? static_cast<size_t>(SSL_CTX_sess_get_cache_size(ctx().get())) : 0;
+    }
+
+
+    //Sets the max number of sessions stored in the session cache.
+    void server_context::set_session_cache_size(size_t size) {
+        SSL_CTX_set_session_cache_mode(ctx().get(), size > 0 ? SSL_SESS_CACHE_SERVER : SSL_SESS_CACHE_OFF);
+        SSL_CTX_sess_set_cache_size(ctx().get(), static_cast<long>(size));
+    }
+
+
+    //Returns the time a session can be resumed for.
+    std::chrono::seconds server_context::session_timeout() const {
+        return std::chrono::seconds(SSL_CTX_get_timeout(ctx().get()));
+    }
+
+
+    //Sets the time a session can be resumed for.
+    void server_context::set_session_timeout(std::chrono::seconds timeout) {
+        SSL_CTX_set_timeout(ctx().get(), static_cast<long>(timeout.count()));
+    }
+
+
+    //Returns the interval after which a new ticket key is created.
+    std::chrono::seconds server_context::ticket_key_rotation_interval() const {
+        ticket_keys& keys = get_ticket_keys(ctx().get());
+        std::lock_guard lock(keys.mutex);
+        return keys.rotation_interval;
+    }
+
+
+    //Sets the interval after which a new ticket key is created.
+    void server_context::set_ticket_key_rotation_interval(std::chrono::seconds interval) {
+        ticket_keys& keys = get_ticket_keys(ctx().get());
+        std::lock_guard lock(keys.mutex);
+        keys.rotation_interval = interval;
+    }
+
+
+    //Creates a new ticket key.
+    void server_context::rotate_ticket_keys() {
+        ticket_keys& keys = get_ticket_keys(ctx().get());
+        std::lock_guard lock(keys.mutex);
+        keys.rotate();
+    }
+
+
 } //namespace netlib::ssl::tcp
@@ -17,7 +17,7 @@ namespace netlib::ssl::tcp {
 
 
     //create the socket
-    static unencrypted::socket::handle_type create_socket(const socket_address& this_addr, int backlog) {
+    static unencrypted::socket::handle_type create_socket(const socket_address& this_addr, int backlog, const socket_options& options) {
         //create the socket
         socket::handle_type sock = ::socket(this_addr.address_family(), SOCK_STREAM, IPPROTO_TCP);
 
@@ -26,6 +26,15 @@ namespace netlib::ssl::tcp {
             throw std::system_error(get_last_error_number(), std::system_category());
         }
 
+        //set the options before listening, so as that the accepted sockets inherit them
+        try {
+            socket::set_options(sock, options);
+        }
+        catch (...) {
+            closesocket(sock);
+            throw;
+        }
+
         //bind the socket; if error, throw exception
         if (::bind(sock, reinterpret_cast<const sockaddr*>(this_addr.data()), sizeof(sockaddr_storage))) {
             throw std::system_error(get_last_error_number(), std::system_category());
@@ -42,17 +51,17 @@ namespace netlib::ssl::tcp {
 
 
     //Creates a socket, binds it to the given address, and listens for connections.
-    server_socket::server_socket(const server_context& context, const socket_address& this_addr, int backlog)
-        : unencrypted::socket(create_socket(this_addr, backlog))
+    server_socket::server_socket(const server_context& context, const socket_address& this_addr, int backlog, const socket_options& options)
+        : unencrypted::socket(create_socket(this_addr, backlog, options))
         , m_ctx(context.ctx())
     {
     }
 
 
     //Accepts a socket connection.
-    std::shared_ptr<client_socket> server_socket::accept(socket_address& addr) {
+    std::shared_ptr<client_socket> server_socket::accept(socket_address& addr, bool non_blocking) {
         //accept
-        int addrlen = sizeof(sockaddr_storage);
+        socklen_t addrlen = sizeof(sockaddr_storage);
         uintptr_t handle = ::accept(this->handle(), reinterpret_cast<sockaddr*>(addr.data()), &addrlen);
 
         //error
@@ -60,12 +69,25 @@ namespace netlib::ssl::tcp {
             throw std::system_error(get_last_error_number(), std::system_category());
         }
 
+        //writing to a socket closed by the peer shall not raise SIGPIPE
+        set_socket_no_sigpipe(handle);
+
         //create ssl
         std::shared_ptr<SSL> ssl{SSL_new(m_ctx.get()), SSL_close};
 
         //bind the ssl and the client socket
         SSL_set_fd(ssl.get(), numeric_cast<int>(handle));
 
+        //non-blocking socket; the handshake is done by the client socket
+        if (non_blocking) {
+            if (set_socket_non_blocking(handle, true)) {
+                throw std::system_error(get_last_error_number(), std::system_category());
+            }
+            SSL_set_mode(ssl.get(), SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+            SSL_set_accept_state(ssl.get());
+            return std::make_shared<internal_client_socket>(m_ctx, ssl);
+        }
+
         //accept
         if (SSL_accept(ssl.get()) != 1) {
             throw ssl::error(ERR_get_error());
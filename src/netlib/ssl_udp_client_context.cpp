@@ -0,0 +1,27 @@
+#include "ssl.hpp"
+#include "netlib/ssl_udp_client_context.hpp"
+#include "netlib/ssl_error.hpp"
+
+
+namespace netlib::ssl::udp {
+
+
+    //create context
+    static std::shared_ptr<SSL_CTX> create_context() {
+        const SSL_METHOD* method = DTLS_client_method();
+        std::shared_ptr<SSL_CTX> ctx{ SSL_CTX_new(method), SSL_CTX_free };
+        if (!ctx) {
+            throw error(ERR_get_error());
+        }
+        return ctx;
+    }
+
+
+    //constructor
+    client_context::client_context(const char* certificate_file, const char* key_file)
+        : ssl::context(create_context(), certificate_file, key_file)
+    {
+    }
+
+
+} //namespace netlib::ssl::udp
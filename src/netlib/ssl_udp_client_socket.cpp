@@ -0,0 +1,155 @@
+#include "platform.hpp"
+#include <system_error>
+#include <algorithm>
+#include <climits>
+#include "ssl.hpp"
+#include "netlib/ssl_udp_client_socket.hpp"
+#include "netlib/ssl_error.hpp"
+#include "netlib/numeric_cast.hpp"
+
+
+namespace netlib::ssl::udp {
+
+
+    //create the socket and the ssl
+    static std::shared_ptr<SSL> create_ssl(const client_context& context, const socket_address& this_addr, const socket_address& server_addr, bool reuse_address_and_port) {
+        //create the socket
+        socket::handle_type sock = ::socket(server_addr.address_family(), SOCK_DGRAM, IPPROTO_UDP);
+
+        //failure to create the socket
+        if (sock == socket::invalid_handle) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+
+        //create the ssl
+        SSL* new_ssl = SSL_new(context.ctx().get());
+        if (!new_ssl) {
+            closesocket(sock);
+            throw ssl::error(ERR_get_error());
+        }
+        std::shared_ptr<SSL> ssl{ new_ssl, DTLS_close };
+
+        //set the bio of the ssl; from now on, the ssl closes the socket
+        BIO* bio = BIO_new_dgram(numeric_cast<int>(sock), BIO_NOCLOSE);
+        if (!bio) {
+            closesocket(sock);
+            throw ssl::error(ERR_get_error());
+        }
+        SSL_set_bio(ssl.get(), bio, bio);
+
+        //set reuse
+        if (reuse_address_and_port) {
+            socket::set_reuse_address_and_port(sock);
+        }
+
+        //bind the socket
+        if (::bind(sock, reinterpret_cast<const sockaddr*>(this_addr.data()), sizeof(sockaddr_storage))) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+
+        //connect the socket
+        if (::connect(sock, reinterpret_cast<const sockaddr*>(server_addr.data()), sizeof(sockaddr_storage))) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+        BIO_ctrl(bio, BIO_CTRL_DGRAM_SET_CONNECTED, 0, const_cast<char*>(server_addr.data()));
+
+        //do the handshake
+        SSL_set_connect_state(ssl.get());
+        dtls_handshake(ssl.get());
+
+        return ssl;
+    }
+
+
+    //receive one message; the part of it that does not fit in the buffer is discarded
+    static bool dtls_receive(SSL* ssl, char* buffer, size_t capacity, size_t& size) {
+        for (;;) {
+            const int s = SSL_read(ssl, buffer, static_cast<int>(std::min(capacity, static_cast<size_t>(INT_MAX))));
+
+            //success
+            if (s > 0) {
+                //discard the rest of the record
+                char temp[1024];
+                while (SSL_pending(ssl) > 0) {
+                    SSL_read(ssl, temp, sizeof(temp));
+                }
+                size = static_cast<size_t>(s);
+                return true;
+            }
+
+            switch (ssl_handle_io_error(ssl, s)) {
+            case ssl_io_result::success:
+                size = 0;
+                return true;
+            case ssl_io_result::failure:
+                return false;
+
+            //a retransmission timer of the handshake expired
+            case ssl_io_result::want_read:
+            case ssl_io_result::want_write:
+                if (DTLSv1_handle_timeout(ssl) < 0) {
+                    throw ssl::error(ERR_get_error());
+                }
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+
+
+    //constructor
+    client_socket::client_socket(const client_context& context, const socket_address& this_addr, const socket_address& server_addr, bool reuse_address_and_port)
+        : ssl::socket(context.ctx(), create_ssl(context, this_addr, server_addr, reuse_address_and_port))
+    {
+    }
+
+
+    //Sends data to the other side.
+    bool client_socket::send(const std::vector<char>& data) {
+        return send(data.data(), data.size());
+    }
+
+
+    //Sends data to the other side.
+    bool client_socket::send(const char* data, size_t size) {
+        return ssl_send(ssl().get(), data, numeric_cast<int>(size));
+    }
+
+
+    //Receives data from the other side.
+    bool client_socket::receive(std::vector<char>& data, const uint16_t max_message_size) {
+        //resize the buffer to hold the max message size
+        data.resize(max_message_size);
+
+        //receive the data
+        size_t size;
+        if (!receive(data.data(), data.size(), size)) {
+            return false;
+        }
+
+        data.resize(size);
+        return true;
+    }
+
+
+    //Receives data from the other side into the given buffer.
+    bool client_socket::receive(char* buffer, size_t capacity, size_t& size) {
+        return dtls_receive(ssl().get(), buffer, capacity, size);
+    }
+
+
+    //Receives data from the other side into a message buffer.
+    bool client_socket::receive(message_buffer& data, const uint16_t max_message_size) {
+        data.reserve(max_message_size);
+        size_t size;
+        if (!receive(data.data(), max_message_size, size)) {
+            return false;
+        }
+        data.resize(size);
+        return true;
+    }
+
+
+} //namespace netlib::ssl::udp
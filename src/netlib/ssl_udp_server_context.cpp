@@ -0,0 +1,113 @@
+#include "platform.hpp"
+#include "ssl.hpp"
+#include <mutex>
+#include "openssl/rand.h"
+#include "openssl/hmac.h"
+#include "openssl/crypto.h"
+#include "netlib/ssl_udp_server_context.hpp"
+#include "netlib/ssl_error.hpp"
+#include "netlib/socket_address.hpp"
+
+
+namespace netlib::ssl::udp {
+
+
+    //cookie secret of a server context
+    struct cookie_secret {
+        std::mutex mutex;
+        unsigned char key[32];
+
+        //creates a new key
+        void rotate() {
+            std::lock_guard lock(mutex);
+            if (RAND_bytes(key, sizeof(key)) <= 0) {
+                throw error(ERR_get_error());
+            }
+        }
+    };
+
+
+    //frees the cookie secret of an SSL_CTX
+    static void free_cookie_secret(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+        delete static_cast<cookie_secret*>(ptr);
+    }
+
+
+    //index of the cookie secret in SSL_CTX ex data
+    static int get_cookie_secret_index() {
+        static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, free_cookie_secret);
+        return index;
+    }
+
+
+    //returns the cookie secret of an SSL_CTX
+    static cookie_secret& get_cookie_secret(SSL_CTX* ctx) {
+        return *static_cast<cookie_secret*>(SSL_CTX_get_ex_data(ctx, get_cookie_secret_index()));
+    }
+
+
+    //computes the cookie of the client the last datagram was received from
+    static bool compute_cookie(SSL* ssl, unsigned char* cookie, unsigned int* cookie_length) {
+        //get the client address
+        socket_address addr;
+        if (BIO_dgram_get_peer(SSL_get_rbio(ssl), addr.data()) <= 0) {
+            return false;
+        }
+
+        //the cookie is the hmac of the client address
+        cookie_secret& secret = get_cookie_secret(SSL_get_SSL_CTX(ssl));
+        std::lock_guard lock(secret.mutex);
+        return HMAC(EVP_sha256(), secret.key, sizeof(secret.key), reinterpret_cast<const unsigned char*>(addr.data()), sizeof(sockaddr_storage), cookie, cookie_length) != nullptr;
+    }
+
+
+    //invoked by OpenSSL for creating the cookie sent to a client
+    static int generate_cookie_callback(SSL* ssl, unsigned char* cookie, unsigned int* cookie_length) {
+        return compute_cookie(ssl, cookie, cookie_length) ? 1 : 0;
+    }
+
+
+    //invoked by OpenSSL for verifying the cookie echoed by a client
+    static int verify_cookie_callback(SSL* ssl, const unsigned char* cookie, unsigned int cookie_length) {
+        unsigned char expected_cookie[EVP_MAX_MD_SIZE];
+        unsigned int expected_cookie_length;
+        return compute_cookie(ssl, expected_cookie, &expected_cookie_length) && cookie_length == expected_cookie_length && CRYPTO_memcmp(cookie, expected_cookie, cookie_length) == 0 ? 1 : 0;
+    }
+
+
+    //create context
+    static std::shared_ptr<SSL_CTX> create_context() {
+        const SSL_METHOD* method = DTLS_server_method();
+        std::shared_ptr<SSL_CTX> ctx{ SSL_CTX_new(method), SSL_CTX_free };
+        if (!ctx) {
+            throw error(ERR_get_error());
+        }
+
+        //cookie exchange
+        cookie_secret* secret = new cookie_secret;
+        if (!SSL_CTX_set_ex_data(ctx.get(), get_cookie_secret_index(), secret)) {
+            delete secret;
+            throw error(ERR_get_error());
+        }
+        secret->rotate();
+        SSL_CTX_set_cookie_generate_cb(ctx.get(), generate_cookie_callback);
+        SSL_CTX_set_cookie_verify_cb(ctx.get(), verify_cookie_callback);
+
+        return ctx;
+    }
+
+
+    //constructor
+    server_context::server_context(const char* certificate_file, const char* key_file)
+        : ssl::context(create_context(), certificate_file, key_file)
+    {
+    }
+
+
+    //Creates a new cookie secret.
+    void server_context::rotate_cookie_secret() {
+        get_cookie_secret(ctx().get()).rotate();
+    }
+
+
+} //namespace netlib::ssl::udp
@@ -0,0 +1,111 @@
+#include "platform.hpp"
+#include "ssl.hpp"
+#include <system_error>
+#include "netlib/ssl_udp_server_socket.hpp"
+#include "netlib/ssl_error.hpp"
+#include "netlib/numeric_cast.hpp"
+
+
+namespace netlib::ssl::udp {
+
+
+    //internal client socket
+    class internal_client_socket : public client_socket {
+    public:
+        internal_client_socket(const std::shared_ptr<ssl_ctx_st>& ctx, const std::shared_ptr<ssl_st>& ssl) : client_socket(ctx, ssl) {}
+    };
+
+
+    //create the socket
+    static unencrypted::socket::handle_type create_socket(const socket_address& addr) {
+        //create the socket
+        socket::handle_type sock = ::socket(addr.address_family(), SOCK_DGRAM, IPPROTO_UDP);
+
+        //failure to create the socket
+        if (sock == socket::invalid_handle) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+
+        //the server socket and the sockets of the connections share the address
+        socket::set_reuse_address_and_port(sock);
+
+        //bind the socket; if error, throw exception
+        if (::bind(sock, reinterpret_cast<const sockaddr*>(addr.data()), sizeof(sockaddr_storage))) {
+            closesocket(sock);
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+
+        //success
+        return sock;
+    }
+
+
+    //Creates a socket and binds it to the given address.
+    server_socket::server_socket(const server_context& context, const socket_address& this_addr)
+        : unencrypted::socket(create_socket(this_addr))
+        , m_ctx(context.ctx())
+    {
+        //get the bound address, in case the port was chosen by the system
+        socklen_t addrlen = sizeof(sockaddr_storage);
+        if (::getsockname(handle(), reinterpret_cast<sockaddr*>(m_address.data()), &addrlen)) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+    }
+
+
+    //Waits for a client that echoes a valid cookie, then does the handshake with it.
+    std::shared_ptr<client_socket> server_socket::accept(socket_address& addr) {
+        //the ssl receives over the server socket, until the cookie exchange is complete
+        std::unique_ptr<SSL, decltype(&SSL_free)> listen_ssl{ SSL_new(m_ctx.get()), SSL_free };
+        BIO* bio = BIO_new_dgram(numeric_cast<int>(handle()), BIO_NOCLOSE);
+        if (!listen_ssl || !bio) {
+            BIO_free(bio);
+            throw ssl::error(ERR_get_error());
+        }
+        SSL_set_bio(listen_ssl.get(), bio, bio);
+        SSL_set_options(listen_ssl.get(), SSL_OP_COOKIE_EXCHANGE);
+
+        //wait for a client hello with a valid cookie
+        std::unique_ptr<BIO_ADDR, decltype(&BIO_ADDR_free)> client_addr{ BIO_ADDR_new(), BIO_ADDR_free };
+        for (;;) {
+            const int r = DTLSv1_listen(listen_ssl.get(), client_addr.get());
+            if (r > 0) {
+                break;
+            }
+            if (r < 0) {
+                throw ssl::error(ERR_get_error());
+            }
+        }
+        addr = socket_address();
+        BIO_dgram_get_peer(bio, addr.data());
+
+        //create the socket of the connection
+        socket::handle_type sock = ::socket(m_address.address_family(), SOCK_DGRAM, IPPROTO_UDP);
+        if (sock == socket::invalid_handle) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+
+        //from now on, the ssl closes the socket of the connection
+        std::shared_ptr<SSL> ssl{ listen_ssl.release(), DTLS_close };
+        BIO_set_fd(bio, numeric_cast<int>(sock), BIO_NOCLOSE);
+
+        //bind the socket to the address of the server socket and connect it to the client,
+        //so as that the datagrams of the client are received by it
+        socket::set_reuse_address_and_port(sock);
+        if (::bind(sock, reinterpret_cast<const sockaddr*>(m_address.data()), sizeof(sockaddr_storage))) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+        if (::connect(sock, reinterpret_cast<const sockaddr*>(addr.data()), sizeof(sockaddr_storage))) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+        BIO_ctrl(bio, BIO_CTRL_DGRAM_SET_CONNECTED, 0, addr.data());
+
+        //complete the handshake
+        dtls_handshake(ssl.get());
+
+        //success
+        return std::make_shared<internal_client_socket>(m_ctx, ssl);
+    }
+
+
+} //namespace netlib::ssl::udp
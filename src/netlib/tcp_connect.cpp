@@ -0,0 +1,229 @@
+#include "platform.hpp"
+#include <stdexcept>
+#include <system_error>
+#include <algorithm>
+#include "tcp_connect.hpp"
+#include "netlib/ip_address.hpp"
+#include "netlib/unencrypted_tcp_client_socket.hpp"
+
+
+namespace netlib {
+
+
+    //connection attempts in progress; the sockets that do not win are closed
+    class connection_attempts {
+    public:
+        ~connection_attempts() {
+            for (const pollfd& pfd : m_fds) {
+                closesocket(pfd.fd);
+            }
+        }
+
+        bool empty() const {
+            return m_fds.empty();
+        }
+
+        void add(socket::handle_type handle) {
+            pollfd pfd{};
+            pfd.fd = handle;
+            pfd.events = POLLOUT;
+            m_fds.push_back(pfd);
+        }
+
+        //waits for an attempt to complete; returns the handle of the connected socket, if any;
+        //failed attempts are closed, and their error is stored
+        socket::handle_type wait(int timeout_ms, int& error, bool& failed) {
+            failed = false;
+            const int r = poll(m_fds.data(), static_cast<unsigned long>(m_fds.size()), timeout_ms);
+            if (r < 0) {
+                throw std::system_error(get_last_error_number(), std::system_category());
+            }
+
+            for (size_t i = 0; i < m_fds.size();) {
+                if (!m_fds[i].revents) {
+                    ++i;
+                    continue;
+                }
+
+                const socket::handle_type handle = m_fds[i].fd;
+                m_fds.erase(m_fds.begin() + i);
+
+                //get the result of the connection
+                int attempt_error = 0;
+                socklen_t error_length = sizeof(attempt_error);
+                if (getsockopt(handle, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&attempt_error), &error_length)) {
+                    attempt_error = get_last_error_number();
+                }
+
+                //success
+                if (!attempt_error) {
+                    return handle;
+                }
+
+                //failure
+                error = attempt_error;
+                failed = true;
+                closesocket(handle);
+            }
+
+            return socket::invalid_handle;
+        }
+
+    private:
+        std::vector<pollfd> m_fds;
+    };
+
+
+    //starts a connection attempt; returns the socket handle, or the invalid handle on failure;
+    //the connected flag is set if the connection is established immediately
+    static socket::handle_type start_connection_attempt(const socket_address& server_addr, const std::optional<socket_address>& this_addr, bool reuse_address_and_port, const socket_options& options, bool& connected, int& error) {
+        const socket::handle_type handle = ::socket(server_addr.address_family(), SOCK_STREAM, IPPROTO_TCP);
+        if (handle == socket::invalid_handle) {
+            error = get_last_error_number();
+            return socket::invalid_handle;
+        }
+
+        //writing to a socket closed by the peer shall not raise SIGPIPE
+        set_socket_no_sigpipe(handle);
+
+        try {
+            //optionally reuse address/port
+            if (reuse_address_and_port) {
+                socket::set_reuse_address_and_port(handle);
+            }
+
+            //set the options before connecting, since some of them affect the connection setup
+            socket::set_options(handle, options);
+        }
+        catch (...) {
+            closesocket(handle);
+            throw;
+        }
+
+        //optionally bind the socket, then connect without waiting
+        if ((!this_addr.has_value() || !::bind(handle, reinterpret_cast<const sockaddr*>(this_addr.value().data()), sizeof(sockaddr_storage))) && !set_socket_non_blocking(handle, true)) {
+            if (!::connect(handle, reinterpret_cast<const sockaddr*>(server_addr.data()), sizeof(sockaddr_storage))) {
+                connected = true;
+                return handle;
+            }
+            if (is_operation_in_progress_error(get_last_error_number())) {
+                connected = false;
+                return handle;
+            }
+        }
+
+        //failure
+        error = get_last_error_number();
+        closesocket(handle);
+        return socket::invalid_handle;
+    }
+
+
+    //returns the number of milliseconds until the given time, rounded up
+    static int get_timeout_ms(std::chrono::steady_clock::time_point time) {
+        const auto duration = time - std::chrono::steady_clock::now();
+        if (duration <= std::chrono::steady_clock::duration::zero()) {
+            return 0;
+        }
+        return static_cast<int>(std::min<std::chrono::milliseconds::rep>(std::chrono::ceil<std::chrono::milliseconds>(duration).count(), INT_MAX));
+    }
+
+
+    //Resolves the addresses of a server, and orders them for connection attempts.
+    std::vector<socket_address> get_connection_addresses(const std::string& hostname, uint16_t port) {
+        const std::vector<ip_address> addrs = ip_address::resolve(hostname);
+
+        //split the addresses by family, keeping the order of the resolver
+        std::vector<socket_address> preferred, other;
+        for (const ip_address& addr : addrs) {
+            (addr.address_family() == addrs.front().address_family() ? preferred : other).emplace_back(addr, port);
+        }
+
+        //interleave the families
+        std::vector<socket_address> result;
+        result.reserve(addrs.size());
+        for (size_t i = 0; i < std::max(preferred.size(), other.size()); ++i) {
+            if (i < preferred.size()) {
+                result.push_back(preferred[i]);
+            }
+            if (i < other.size()) {
+                result.push_back(other[i]);
+            }
+        }
+        return result;
+    }
+
+
+    //Connects a tcp socket to the first address that accepts the connection.
+    socket::handle_type tcp_connect(const std::vector<socket_address>& server_addrs, const std::optional<socket_address>& this_addr, bool reuse_address_and_port, const socket_options& options, std::chrono::steady_clock::time_point deadline) {
+        static constexpr std::chrono::milliseconds attempt_delay(NETLIB_TCP_CONNECTION_ATTEMPT_DELAY);
+
+        if (server_addrs.empty()) {
+            throw std::invalid_argument("No server address.");
+        }
+
+        connection_attempts attempts;
+        int error = get_connection_timeout_error_number();
+        size_t next_index = 0;
+        auto next_attempt_time = std::chrono::steady_clock::now();
+
+        for (;;) {
+            //start the next attempt when it is due, or when there is no attempt in progress
+            if (next_index < server_addrs.size() && (attempts.empty() || std::chrono::steady_clock::now() >= next_attempt_time)) {
+                bool connected;
+                const socket::handle_type handle = start_connection_attempt(server_addrs[next_index++], this_addr, reuse_address_and_port, options, connected, error);
+                if (handle == socket::invalid_handle) {
+                    next_attempt_time = std::chrono::steady_clock::now();
+                    continue;
+                }
+                if (connected) {
+                    return handle;
+                }
+                attempts.add(handle);
+                next_attempt_time = std::chrono::steady_clock::now() + attempt_delay;
+                continue;
+            }
+
+            //all the attempts failed
+            if (attempts.empty()) {
+                throw std::system_error(error, std::system_category());
+            }
+
+            //the deadline passed
+            if (std::chrono::steady_clock::now() >= deadline) {
+                throw std::system_error(get_connection_timeout_error_number(), std::system_category());
+            }
+
+            //wait for an attempt to complete, until the next attempt is due
+            const auto wait_time = next_index < server_addrs.size() ? std::min(deadline, next_attempt_time) : deadline;
+            bool failed;
+            const socket::handle_type handle = attempts.wait(get_timeout_ms(wait_time), error, failed);
+            if (handle != socket::invalid_handle) {
+                return handle;
+            }
+
+            //a failed attempt lets the next attempt start immediately
+            if (failed) {
+                next_attempt_time = std::chrono::steady_clock::now();
+            }
+        }
+    }
+
+
+    //Waits for the given poll events of a socket, until the deadline.
+    void wait_socket(socket::handle_type handle, short events, std::chrono::steady_clock::time_point deadline) {
+        pollfd pfd{};
+        pfd.fd = handle;
+        pfd.events = events;
+
+        const int r = poll(&pfd, 1, get_timeout_ms(deadline));
+        if (r < 0) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+        if (r == 0) {
+            throw std::system_error(get_connection_timeout_error_number(), std::system_category());
+        }
+    }
+
+
+} //namespace netlib
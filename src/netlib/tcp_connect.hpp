@@ -0,0 +1,40 @@
+#ifndef NETLIB_TCP_CONNECT_HPP
+#define NETLIB_TCP_CONNECT_HPP
+
+
+#include <vector>
+#include <string>
+#include <optional>
+#include <chrono>
+#include <cstdint>
+#include "netlib/socket.hpp"
+#include "netlib/socket_address.hpp"
+#include "netlib/socket_options.hpp"
+
+
+namespace netlib {
+
+
+    //resolves the addresses of a server, and orders them for connection attempts as in RFC 8305:
+    //the address families alternate, starting with the family the resolver prefers
+    std::vector<socket_address> get_connection_addresses(const std::string& hostname, uint16_t port);
+
+
+    //connects a tcp socket to the first address that accepts the connection;
+    //a new attempt starts every connection attempt delay, or as soon as the previous attempts fail,
+    //and the first attempt that succeeds wins; the others are closed;
+    //returns the handle of the connected socket, which is non-blocking;
+    //throws std::system_error with the error of the last attempt, if all the attempts fail,
+    //or with the connection timeout error, if the deadline passes
+    socket::handle_type tcp_connect(const std::vector<socket_address>& server_addrs, const std::optional<socket_address>& this_addr, bool reuse_address_and_port, const socket_options& options, std::chrono::steady_clock::time_point deadline);
+
+
+    //waits for the given poll events of a socket, until the deadline;
+    //throws std::system_error with the connection timeout error, if the deadline passes
+    void wait_socket(socket::handle_type handle, short events, std::chrono::steady_clock::time_point deadline);
+
+
+} //namespace netlib
+
+
+#endif //NETLIB_TCP_CONNECT_HPP
@@ -0,0 +1,188 @@
+#include "platform.hpp"
+#include <algorithm>
+#include "udp_offload.hpp"
+#include "netlib/numeric_cast.hpp"
+
+
+namespace netlib::unencrypted::udp {
+
+
+    //max payload of a datagram sent with segmentation offload
+    static constexpr size_t max_segmented_payload_size = 65507;
+
+
+    //max number of segments per datagram sent with segmentation offload
+    static constexpr size_t max_segment_count = 64;
+
+
+    //sends one datagram
+    static int send_datagram(uintptr_t handle, const char* data, size_t size, const socket_address* receiver_addr) {
+        if (receiver_addr) {
+            return ::sendto(handle, data, numeric_cast<int>(size), MSG_NOSIGNAL, reinterpret_cast<const sockaddr*>(receiver_addr->data()), sizeof(sockaddr_storage));
+        }
+        return ::send(handle, data, numeric_cast<int>(size), MSG_NOSIGNAL);
+    }
+
+
+    //sends the segments one by one
+    static int send_datagrams(uintptr_t handle, const char* data, size_t size, size_t segment_size, const socket_address* receiver_addr) {
+        size_t sent_size = 0;
+        while (sent_size < size) {
+            const size_t count = std::min(segment_size, size - sent_size);
+            if (send_datagram(handle, data + sent_size, count, receiver_addr) < 0) {
+                return -1;
+            }
+            sent_size += count;
+        }
+        return numeric_cast<int>(sent_size);
+    }
+
+
+    #if defined(__linux__) && defined(UDP_SEGMENT) && defined(UDP_GRO)
+
+
+    //Enables or disables generic receive offload.
+    bool set_receive_offload(uintptr_t handle, bool enabled) {
+        const int value = enabled ? 1 : 0;
+        return ::setsockopt(handle, SOL_UDP, UDP_GRO, &value, sizeof(value)) == 0;
+    }
+
+
+    //sends segments with one system call
+    static int send_segmented_datagram(uintptr_t handle, const char* data, size_t size, size_t segment_size, const socket_address* receiver_addr) {
+        iovec io_vector{};
+        io_vector.iov_base = const_cast<char*>(data);
+        io_vector.iov_len = size;
+
+        msghdr message{};
+        if (receiver_addr) {
+            message.msg_name = const_cast<char*>(receiver_addr->data());
+            message.msg_namelen = sizeof(sockaddr_storage);
+        }
+        message.msg_iov = &io_vector;
+        message.msg_iovlen = 1;
+
+        //set the segment size
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(uint16_t))]{};
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        const uint16_t gso_size = static_cast<uint16_t>(segment_size);
+        std::memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+
+        return static_cast<int>(::sendmsg(handle, &message, MSG_NOSIGNAL));
+    }
+
+
+    //Sends data as segments of the given size.
+    int send_segments(uintptr_t handle, const char* data, size_t size, size_t segment_size, const socket_address* receiver_addr) {
+        //segments too large for offload
+        const size_t segments_per_datagram = std::min(max_segment_count, max_segmented_payload_size / segment_size);
+        if (segments_per_datagram < 2) {
+            return send_datagrams(handle, data, size, segment_size, receiver_addr);
+        }
+
+        const size_t max_datagram_size = segments_per_datagram * segment_size;
+
+        size_t sent_size = 0;
+        while (sent_size < size) {
+            const size_t count = std::min(max_datagram_size, size - sent_size);
+
+            //single segment
+            if (count <= segment_size) {
+                if (send_datagram(handle, data + sent_size, count, receiver_addr) < 0) {
+                    return -1;
+                }
+            }
+
+            //multiple segments; if the offload is not supported by the socket or the device, send the segments one by one
+            else if (send_segmented_datagram(handle, data + sent_size, count, segment_size, receiver_addr) < 0) {
+                const int error = get_last_error_number();
+                if (error != EIO && error != ENOPROTOOPT && error != EOPNOTSUPP && error != EINVAL) {
+                    return -1;
+                }
+                if (send_datagrams(handle, data + sent_size, count, segment_size, receiver_addr) < 0) {
+                    return -1;
+                }
+            }
+
+            sent_size += count;
+        }
+
+        return numeric_cast<int>(sent_size);
+    }
+
+
+    //Receives a datagram, or coalesced segments.
+    int receive_segments(uintptr_t handle, char* buffer, size_t capacity, size_t& segment_size, socket_address* sender_addr) {
+        iovec io_vector{};
+        io_vector.iov_base = buffer;
+        io_vector.iov_len = capacity;
+
+        msghdr message{};
+        if (sender_addr) {
+            message.msg_name = sender_addr->data();
+            message.msg_namelen = sizeof(socket_address);
+        }
+        message.msg_iov = &io_vector;
+        message.msg_iovlen = 1;
+
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+
+        const int bytes = static_cast<int>(::recvmsg(handle, &message, 0));
+        if (bytes < 0) {
+            return bytes;
+        }
+
+        //get the segment size; if not coalesced, the datagram is one segment
+        segment_size = static_cast<size_t>(bytes);
+        for (cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg; cmsg = CMSG_NXTHDR(&message, cmsg)) {
+            if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+                int gso_size;
+                std::memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+                segment_size = static_cast<size_t>(gso_size);
+                break;
+            }
+        }
+
+        return bytes;
+    }
+
+
+    #else
+
+
+    //Enables or disables generic receive offload; not supported.
+    bool set_receive_offload(uintptr_t handle, bool enabled) {
+        return !enabled;
+    }
+
+
+    //Sends data as segments of the given size, one by one.
+    int send_segments(uintptr_t handle, const char* data, size_t size, size_t segment_size, const socket_address* receiver_addr) {
+        return send_datagrams(handle, data, size, segment_size, receiver_addr);
+    }
+
+
+    //Receives a datagram.
+    int receive_segments(uintptr_t handle, char* buffer, size_t capacity, size_t& segment_size, socket_address* sender_addr) {
+        socklen_t fromlen = sizeof(socket_address);
+        const int bytes = sender_addr ?
+            ::recvfrom(handle, buffer, numeric_cast<int>(capacity), 0, reinterpret_cast<sockaddr*>(sender_addr->data()), &fromlen) :
+            ::recv(handle, buffer, numeric_cast<int>(capacity), 0);
+        if (bytes >= 0) {
+            segment_size = static_cast<size_t>(bytes);
+        }
+        return bytes;
+    }
+
+
+    #endif
+
+
+} //namespace netlib::unencrypted::udp
@@ -0,0 +1,32 @@
+#ifndef NETLIB_UDP_OFFLOAD_HPP
+#define NETLIB_UDP_OFFLOAD_HPP
+
+
+#include <cstddef>
+#include <cstdint>
+#include "netlib/socket_address.hpp"
+
+
+namespace netlib::unencrypted::udp {
+
+
+    //enables or disables generic receive offload; returns false if it is not supported
+    bool set_receive_offload(uintptr_t handle, bool enabled);
+
+
+    //sends data as segments of the given size, using segmentation offload if available;
+    //if the receiver address is null, the socket must be connected;
+    //returns the number of bytes sent, or -1 on error
+    int send_segments(uintptr_t handle, const char* data, size_t size, size_t segment_size, const socket_address* receiver_addr);
+
+
+    //receives a datagram, or coalesced segments if generic receive offload is enabled;
+    //if the sender address is null, it is not returned;
+    //returns the number of bytes received, or -1 on error
+    int receive_segments(uintptr_t handle, char* buffer, size_t capacity, size_t& segment_size, socket_address* sender_addr);
+
+
+} //namespace netlib::unencrypted::udp
+
+
+#endif //NETLIB_UDP_OFFLOAD_HPP
@@ -16,6 +16,7 @@ namespace netlib::unencrypted {
         if (handle < 0) {
             throw std::system_error(get_last_error_number(), std::system_category());
         }
+        set_socket_no_sigpipe(handle);
     }
 
 
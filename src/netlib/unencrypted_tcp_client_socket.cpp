@@ -1,25 +1,127 @@
 #include "platform.hpp"
 #include <stdexcept>
 #include <system_error>
+#include <algorithm>
+#include <cstring>
 #include "netlib/unencrypted_tcp_client_socket.hpp"
 #include "netlib/numeric_cast.hpp"
 #include "netlib/endianess.hpp"
 #include "netlib/message_size_t.hpp"
+#include "tcp_connect.hpp"
 
 
 namespace netlib::unencrypted::tcp {
 
 
-    //send data
-    static bool _send(uintptr_t handle, const char* d, int len) {
-        do {
+    #ifdef _WIN32
+
+
+    //buffer for vectored send
+    using send_buffer = WSABUF;
+
+
+    //max number of buffers per system call
+    static constexpr size_t max_send_buffer_count = 1024;
+
+
+    //sets a buffer for vectored send
+    static void set_send_buffer(send_buffer& buffer, const char* data, size_t size) {
+        buffer.buf = const_cast<char*>(data);
+        buffer.len = numeric_cast<ULONG>(size);
+    }
+
+
+    //returns the size of a buffer for vectored send
+    static size_t get_send_buffer_size(const send_buffer& buffer) {
+        return buffer.len;
+    }
+
+
+    //skips the given number of bytes from the start of a buffer for vectored send
+    static void advance_send_buffer(send_buffer& buffer, size_t size) {
+        buffer.buf += size;
+        buffer.len -= static_cast<ULONG>(size);
+    }
+
+
+    //sends buffers with one system call
+    static int send_buffers(uintptr_t handle, send_buffer* buffers, size_t count, size_t& sent_size) {
+        DWORD size;
+        const int result = WSASend(handle, buffers, static_cast<DWORD>(count), &size, 0, nullptr, nullptr);
+        sent_size = size;
+        return result;
+    }
+
+
+    #else
+
+
+    //buffer for vectored send
+    using send_buffer = iovec;
+
+
+    //max number of buffers per system call
+    static constexpr size_t max_send_buffer_count = IOV_MAX;
+
+
+    //sets a buffer for vectored send
+    static void set_send_buffer(send_buffer& buffer, const char* data, size_t size) {
+        buffer.iov_base = const_cast<char*>(data);
+        buffer.iov_len = size;
+    }
+
+
+    //returns the size of a buffer for vectored send
+    static size_t get_send_buffer_size(const send_buffer& buffer) {
+        return buffer.iov_len;
+    }
+
+
+    //skips the given number of bytes from the start of a buffer for vectored send
+    static void advance_send_buffer(send_buffer& buffer, size_t size) {
+        buffer.iov_base = static_cast<char*>(buffer.iov_base) + size;
+        buffer.iov_len -= size;
+    }
+
+
+    //sends buffers with one system call
+    static int send_buffers(uintptr_t handle, send_buffer* buffers, size_t count, size_t& sent_size) {
+        msghdr message{};
+        message.msg_iov = buffers;
+        message.msg_iovlen = count;
+        const ssize_t result = sendmsg(static_cast<int>(handle), &message, MSG_NOSIGNAL);
+        if (result < 0) {
+            return -1;
+        }
+        sent_size = static_cast<size_t>(result);
+        return 0;
+    }
+
+
+    #endif
+
+
+    //skips the given number of bytes from the start of multiple buffers
+    static void skip_send_buffers(send_buffer*& buffers, size_t& count, size_t size) {
+        for (; count > 0 && size >= get_send_buffer_size(*buffers); ++buffers, --count) {
+            size -= get_send_buffer_size(*buffers);
+        }
+        if (size > 0) {
+            advance_send_buffer(*buffers, size);
+        }
+    }
+
+
+    //send data from multiple buffers, with one system call per max_send_buffer_count buffers
+    static bool _send(uintptr_t handle, send_buffer* buffers, size_t count) {
+        while (count > 0) {
             //send
-            int s = ::send(handle, d, len, 0);
+            size_t sent_size;
+            int s = send_buffers(handle, buffers, std::min(count, max_send_buffer_count), sent_size);
 
-            //success
-            if (s >= 0) {
-                d += s;
-                len -= s;
+            //success; skip the data sent
+            if (s == 0) {
+                skip_send_buffers(buffers, count, sent_size);
                 continue;
             }
 
@@ -30,42 +132,34 @@ namespace netlib::unencrypted::tcp {
 
             //error
             throw std::system_error(get_last_error_number(), std::system_category());
-
-        } while (len > 0);
+        }
 
         return true;
     }
 
 
-    //receive data
-    static bool _receive(uintptr_t handle, char* d, int len) {
-        do {
-            //receive
-            int s = recv(handle, d, len, 0);
+    //receive the available data; returns 0 if the socket is closed
+    static int _receive_available(uintptr_t handle, char* d, size_t len) {
+        //receive
+        int s = recv(handle, d, numeric_cast<int>(len), 0);
 
-            //success
-            if (s > 0) {
-                d += s;
-                len -= s;
-                continue;
-            }
-
-            //special case/if closed
-            if (s == 0 || is_socket_closed_error(get_last_error_number())) {
-                return false;
-            }
-
-            //error
-            throw std::system_error(get_last_error_number(), std::system_category());
+        //success
+        if (s > 0) {
+            return s;
+        }
 
-        } while (len > 0);
+        //special case/if closed
+        if (s == 0 || is_socket_closed_error(get_last_error_number())) {
+            return 0;
+        }
 
-        return true;
+        //error
+        throw std::system_error(get_last_error_number(), std::system_category());
     }
 
 
     //Constructor.
-    client_socket::client_socket(const std::optional<socket_address>& this_addr, const socket_address& server_addr, bool reuse_address_and_port)
+    client_socket::client_socket(const std::optional<socket_address>& this_addr, const socket_address& server_addr, bool reuse_address_and_port, const socket_options& options)
         : socket(::socket(server_addr.address_family(), SOCK_STREAM, IPPROTO_TCP))
     {
         //optionally reuse address/port
@@ -73,6 +167,9 @@ namespace netlib::unencrypted::tcp {
             set_reuse_address_and_port();
         }
 
+        //set the options before connecting, since some of them affect the connection setup
+        set_options(options);
+
         //optionally bind the socket
         if (this_addr.has_value() && ::bind(handle(), reinterpret_cast<const sockaddr*>(this_addr.value().data()), sizeof(sockaddr_storage))) {
             throw std::system_error(get_last_error_number(), std::system_category());
@@ -85,34 +182,228 @@ namespace netlib::unencrypted::tcp {
     }
 
 
+    //Constructor with connection timeout.
+    client_socket::client_socket(const std::optional<socket_address>& this_addr, const socket_address& server_addr, std::chrono::milliseconds timeout, bool reuse_address_and_port, const socket_options& options)
+        : socket(tcp_connect({ server_addr }, this_addr, reuse_address_and_port, options, std::chrono::steady_clock::now() + timeout))
+    {
+        //the socket is blocking after the connection
+        if (set_socket_non_blocking(handle(), false)) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+    }
+
+
+    //Constructor from hostname, with connection timeout.
+    client_socket::client_socket(const std::string& hostname, uint16_t port, std::chrono::milliseconds timeout, const socket_options& options)
+        : socket(tcp_connect(get_connection_addresses(hostname, port), std::nullopt, false, options, std::chrono::steady_clock::now() + timeout))
+    {
+        //the socket is blocking after the connection
+        if (set_socket_non_blocking(handle(), false)) {
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+    }
+
+
     //Sends data to the server.
     bool client_socket::send(const std::vector<char>& data) {
-        message_size_t size = numeric_cast<message_size_t>(data.size());
+        return send(data.data(), data.size());
+    }
 
-        //send size
-        set_endianess(size);
-        if (!_send(handle(), reinterpret_cast<const char*>(&size), sizeof(size))) {
-            return false;
+
+    //Sends data to the server.
+    bool client_socket::send(const char* data, size_t size) {
+        message_size_t message_size = numeric_cast<message_size_t>(size);
+        set_endianess(message_size);
+
+        //send size and data with one system call
+        send_buffer buffers[2];
+        set_send_buffer(buffers[0], reinterpret_cast<const char*>(&message_size), sizeof(message_size));
+        set_send_buffer(buffers[1], data, size);
+        return _send(handle(), buffers, 2);
+    }
+
+
+    //Sends multiple messages to the server.
+    bool client_socket::send_batch(const std::vector<std::vector<char>>& messages) {
+        std::vector<message_size_t> sizes(messages.size());
+        std::vector<send_buffer> buffers(messages.size() * 2);
+
+        //prepare the size and data of each message
+        for (size_t i = 0; i < messages.size(); ++i) {
+            sizes[i] = numeric_cast<message_size_t>(messages[i].size());
+            set_endianess(sizes[i]);
+            set_send_buffer(buffers[i * 2], reinterpret_cast<const char*>(&sizes[i]), sizeof(message_size_t));
+            set_send_buffer(buffers[i * 2 + 1], messages[i].data(), messages[i].size());
         }
 
-        //send data
-        return _send(handle(), data.data(), numeric_cast<int>(data.size()));
+        //send all messages
+        return _send(handle(), buffers.data(), buffers.size());
+    }
+
+
+    //Sends data to the server, without blocking.
+    io_status client_socket::send_non_blocking(const char* data, size_t size, size_t& offset) {
+        message_size_t message_size = numeric_cast<message_size_t>(size);
+        set_endianess(message_size);
+
+        //skip the bytes sent by the previous calls
+        send_buffer buffers[2];
+        set_send_buffer(buffers[0], reinterpret_cast<const char*>(&message_size), sizeof(message_size));
+        set_send_buffer(buffers[1], data, size);
+        send_buffer* remaining_buffers = buffers;
+        size_t count = 2;
+        skip_send_buffers(remaining_buffers, count, offset);
+
+        while (count > 0) {
+            //send
+            size_t sent_size;
+            const int s = send_buffers(handle(), remaining_buffers, count, sent_size);
+
+            //success; skip the data sent
+            if (s == 0) {
+                offset += sent_size;
+                skip_send_buffers(remaining_buffers, count, sent_size);
+                continue;
+            }
+
+            //the socket cannot take more data
+            const int error = get_last_error_number();
+            if (is_operation_in_progress_error(error)) {
+                return io_status::want_write;
+            }
+
+            //if closed
+            if (is_socket_closed_error(error)) {
+                return io_status::closed;
+            }
+
+            //error
+            throw std::system_error(error, std::system_category());
+        }
+
+        return io_status::done;
+    }
+
+
+    //Receives data from the server, without blocking.
+    io_status client_socket::receive_non_blocking(std::vector<char>& data) {
+        io_status status = io_status::want_read;
+
+        const auto receive_available = [&](char* d, size_t len) {
+            const int s = recv(handle(), d, numeric_cast<int>(len), 0);
+
+            //success
+            if (s > 0) {
+                return s;
+            }
+
+            //special case/if closed
+            if (s == 0 || is_socket_closed_error(get_last_error_number())) {
+                status = io_status::closed;
+                return 0;
+            }
+
+            //no data available
+            if (is_operation_in_progress_error(get_last_error_number())) {
+                return 0;
+            }
+
+            //error
+            throw std::system_error(get_last_error_number(), std::system_category());
+        };
+
+        for (;;) {
+            size_t message_size = sizeof(message_size_t);
+
+            //if the size of the message is buffered, the whole message is required
+            if (m_receive_buffer.size() >= sizeof(message_size_t)) {
+                message_size_t size;
+                std::memcpy(&size, m_receive_buffer.data(), sizeof(size));
+                set_endianess(size);
+                message_size += size;
+
+                //the whole message is buffered
+                if (m_receive_buffer.size() >= message_size) {
+                    data.assign(m_receive_buffer.data() + sizeof(size), m_receive_buffer.data() + message_size);
+                    m_receive_buffer.consume(message_size);
+                    return io_status::done;
+                }
+            }
+
+            //receive the available data
+            if (m_receive_buffer.fill(message_size, receive_available) <= 0) {
+                return status;
+            }
+        }
     }
 
 
     //Receives data from the server.
     bool client_socket::receive(std::vector<char>& data) {
+        const auto receive_available = [&](char* d, size_t len) {
+            return _receive_available(handle(), d, len);
+        };
+
+        message_size_t size;
+
+        //receive size; the following messages might be received together with it
+        if (!m_receive_buffer.read(reinterpret_cast<char*>(&size), sizeof(size), receive_available)) {
+            return false;
+        }
+        set_endianess(size);
+
+        //receive data
+        data.resize(size);
+        return m_receive_buffer.read(data.data(), size, receive_available);
+    }
+
+
+    //Receives data from the server into the given buffer.
+    bool client_socket::receive(char* buffer, size_t capacity, size_t& size) {
+        const auto receive_available = [&](char* d, size_t len) {
+            return _receive_available(handle(), d, len);
+        };
+
+        message_size_t message_size;
+
+        //receive size
+        if (!m_receive_buffer.read(reinterpret_cast<char*>(&message_size), sizeof(message_size), receive_available)) {
+            return false;
+        }
+        set_endianess(message_size);
+
+        //if the message does not fit, discard it, so as that the next message can be received
+        if (message_size > capacity) {
+            if (!m_receive_buffer.skip(message_size, receive_available)) {
+                return false;
+            }
+            throw std::length_error("Message does not fit in the buffer.");
+        }
+
+        //receive data
+        size = message_size;
+        return m_receive_buffer.read(buffer, message_size, receive_available);
+    }
+
+
+    //Receives data from the server into a message buffer.
+    bool client_socket::receive(message_buffer& data) {
+        const auto receive_available = [&](char* d, size_t len) {
+            return _receive_available(handle(), d, len);
+        };
+
         message_size_t size;
 
         //receive size
-        if (!_receive(handle(), reinterpret_cast<char*>(&size), sizeof(size))) {
+        if (!m_receive_buffer.read(reinterpret_cast<char*>(&size), sizeof(size), receive_available)) {
             return false;
         }
         set_endianess(size);
 
         //receive data
+        data.reserve(size);
         data.resize(size);
-        return _receive(handle(), data.data(), numeric_cast<int>(size));
+        return m_receive_buffer.read(data.data(), size, receive_available);
     }
 
 
@@ -0,0 +1,36 @@
+#include "netlib/unencrypted_tcp_connection_pool.hpp"
+
+
+namespace netlib::unencrypted::tcp {
+
+
+    //Constructor.
+    connection_pool::connection_pool(const connection_pool_options& options) : netlib::connection_pool(options) {
+    }
+
+
+    //Returns a connection to the given server.
+    std::shared_ptr<client_socket> connection_pool::acquire(const socket_address& server_addr) {
+        const key k{ server_addr, nullptr, {} };
+        const auto deadline = std::chrono::steady_clock::now() + options().connect_timeout;
+
+        //reuse an idle connection
+        std::unique_ptr<netlib::socket> s = checkout(k, deadline);
+        if (s) {
+            return hand_out(k, std::unique_ptr<client_socket>(static_cast<client_socket*>(s.release())));
+        }
+
+        //else create a new connection
+        std::unique_ptr<client_socket> cs;
+        try {
+            cs = std::make_unique<client_socket>(std::nullopt, server_addr, get_remaining_time(deadline), false, options().connection_options);
+        }
+        catch (...) {
+            cancel(k);
+            throw;
+        }
+        return hand_out(k, std::move(cs));
+    }
+
+
+} //namespace netlib::unencrypted::tcp
@@ -8,9 +8,12 @@ namespace netlib::unencrypted::tcp {
 
 
     //Creates a socket, binds it to the given address, and listens for connections.
-    server_socket::server_socket(const socket_address& this_addr, int backlog)
+    server_socket::server_socket(const socket_address& this_addr, int backlog, const socket_options& options)
         : socket(::socket(this_addr.address_family(), SOCK_STREAM, IPPROTO_TCP))
     {
+        //set the options before listening, so as that the accepted sockets inherit them
+        set_options(options);
+
         if (::bind(handle(), reinterpret_cast<const sockaddr*>(this_addr.data()), sizeof(sockaddr_storage))) {
             throw std::system_error(get_last_error_number(), std::system_category());
         }
@@ -24,7 +27,7 @@ namespace netlib::unencrypted::tcp {
     //Accepts a socket connection.
     std::shared_ptr<client_socket> server_socket::accept(socket_address& addr) {
         //accept
-        int addrlen = sizeof(sockaddr_storage);
+        socklen_t addrlen = sizeof(sockaddr_storage);
         uintptr_t handle = ::accept(this->handle(), reinterpret_cast<sockaddr*>(addr.data()), &addrlen);
 
         //if no error
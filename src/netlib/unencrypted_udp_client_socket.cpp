@@ -3,6 +3,7 @@
 #include <system_error>
 #include "netlib/unencrypted_udp_client_socket.hpp"
 #include "netlib/numeric_cast.hpp"
+#include "udp_offload.hpp"
 
 
 namespace netlib::unencrypted::udp {
@@ -31,9 +32,15 @@ namespace netlib::unencrypted::udp {
 
     //Sends data to the server.
     bool client_socket::send(const std::vector<char>& data) {
-        int bytes = ::send(handle(), data.data(), numeric_cast<int>(data.size()), 0);
+        return send(data.data(), data.size());
+    }
+
+
+    //Sends data to the server.
+    bool client_socket::send(const char* data, size_t size) {
+        int bytes = ::send(handle(), data, numeric_cast<int>(size), MSG_NOSIGNAL);
 
-        if (bytes == data.size()) {
+        if (bytes == size) {
             return true;
         }
 
@@ -51,11 +58,84 @@ namespace netlib::unencrypted::udp {
         data.resize(max_message_size);
 
         //receive the data
-        int bytes = ::recv(handle(), data.data(), static_cast<int>(data.size()), 0);
+        size_t size;
+        if (!receive(data.data(), data.size(), size)) {
+            return false;
+        }
+
+        data.resize(size);
+        return true;
+    }
+
+
+    //Receives data from the server into the given buffer.
+    bool client_socket::receive(char* buffer, size_t capacity, size_t& size) {
+        //receive the data
+        int bytes = ::recv(handle(), buffer, numeric_cast<int>(capacity), 0);
+
+        //receive ok
+        if (bytes >= 0) {
+            size = static_cast<size_t>(bytes);
+            return true;
+        }
+
+        //socket closed
+        if (is_socket_closed_error(get_last_error_number())) {
+            return false;
+        }
+
+        //error
+        throw std::system_error(get_last_error_number(), std::system_category());
+    }
+
+
+    //Receives data from the server into a message buffer.
+    bool client_socket::receive(message_buffer& data, const uint16_t max_message_size) {
+        data.reserve(max_message_size);
+        size_t size;
+        if (!receive(data.data(), max_message_size, size)) {
+            return false;
+        }
+        data.resize(size);
+        return true;
+    }
+
+
+    //Enables or disables generic receive offload.
+    bool client_socket::set_receive_offload(bool enabled) {
+        return udp::set_receive_offload(handle(), enabled);
+    }
+
+
+    //Sends data as datagrams of the given segment size.
+    bool client_socket::send_segments(const char* data, size_t size, size_t segment_size) {
+        //the segment size must not be 0
+        if (segment_size == 0) {
+            throw std::invalid_argument("Invalid segment size.");
+        }
+
+        //send ok
+        if (udp::send_segments(handle(), data, size, segment_size, nullptr) >= 0) {
+            return true;
+        }
+
+        //socket closed
+        if (is_socket_closed_error(get_last_error_number())) {
+            return false;
+        }
+
+        //error
+        throw std::system_error(get_last_error_number(), std::system_category());
+    }
+
+
+    //Receives data from the server, possibly as coalesced segments.
+    bool client_socket::receive_segments(char* buffer, size_t capacity, size_t& size, size_t& segment_size) {
+        const int bytes = udp::receive_segments(handle(), buffer, capacity, segment_size, nullptr);
 
         //receive ok
         if (bytes >= 0) {
-            data.resize(bytes);
+            size = static_cast<size_t>(bytes);
             return true;
         }
 
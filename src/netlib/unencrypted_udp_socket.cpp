@@ -1,13 +1,110 @@
 #include "platform.hpp"
 #include <stdexcept>
 #include <system_error>
+#include <algorithm>
 #include "netlib/unencrypted_udp_socket.hpp"
 #include "netlib/numeric_cast.hpp"
+#include "udp_offload.hpp"
 
 
 namespace netlib::unencrypted::udp {
 
 
+    //max number of datagrams per system call
+    static constexpr size_t max_batch_size = 64;
+
+
+    #ifdef __linux__
+
+
+    //sends datagrams with one system call; returns the number of datagrams sent, or -1 on error
+    static int send_datagrams(uintptr_t handle, const datagram* datagrams, size_t count) {
+        count = std::min(count, max_batch_size);
+        mmsghdr messages[max_batch_size];
+        iovec buffers[max_batch_size];
+        for (size_t i = 0; i < count; ++i) {
+            buffers[i].iov_base = datagrams[i].buffer;
+            buffers[i].iov_len = datagrams[i].size;
+            messages[i] = mmsghdr{};
+            messages[i].msg_hdr.msg_name = const_cast<char*>(datagrams[i].address.data());
+            messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            messages[i].msg_hdr.msg_iov = &buffers[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+        return ::sendmmsg(handle, messages, static_cast<unsigned int>(count), MSG_NOSIGNAL);
+    }
+
+
+    //receives the available datagrams with one system call, after waiting for the first one;
+    //returns the number of datagrams received, or -1 on error
+    static int receive_datagrams(uintptr_t handle, datagram* datagrams, size_t count) {
+        count = std::min(count, max_batch_size);
+        mmsghdr messages[max_batch_size];
+        iovec buffers[max_batch_size];
+        for (size_t i = 0; i < count; ++i) {
+            buffers[i].iov_base = datagrams[i].buffer;
+            buffers[i].iov_len = datagrams[i].capacity;
+            messages[i] = mmsghdr{};
+            messages[i].msg_hdr.msg_name = datagrams[i].address.data();
+            messages[i].msg_hdr.msg_namelen = sizeof(socket_address);
+            messages[i].msg_hdr.msg_iov = &buffers[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        const int result = ::recvmmsg(handle, messages, static_cast<unsigned int>(count), MSG_WAITFORONE, nullptr);
+
+        for (int i = 0; i < result; ++i) {
+            datagrams[i].size = messages[i].msg_len;
+        }
+
+        return result;
+    }
+
+
+    #else
+
+
+    //sends one datagram; returns 1, or -1 on error
+    static int send_datagrams(uintptr_t handle, const datagram* datagrams, size_t count) {
+        const int bytes = ::sendto(handle, datagrams->buffer, numeric_cast<int>(datagrams->size), MSG_NOSIGNAL, reinterpret_cast<const sockaddr*>(datagrams->address.data()), sizeof(sockaddr_storage));
+        return bytes >= 0 ? 1 : -1;
+    }
+
+
+    //receives the available datagrams one by one, after waiting for the first one;
+    //returns the number of datagrams received, or -1 on error
+    static int receive_datagrams(uintptr_t handle, datagram* datagrams, size_t count) {
+        count = std::min(count, max_batch_size);
+
+        for (size_t i = 0; i < count; ++i) {
+            //after the first datagram, stop when no more datagrams are available
+            if (i > 0) {
+                pollfd pfd{};
+                pfd.fd = handle;
+                pfd.events = POLLIN;
+                if (::poll(&pfd, 1, 0) <= 0) {
+                    return static_cast<int>(i);
+                }
+            }
+
+            socklen_t fromlen = sizeof(socket_address);
+            const int bytes = ::recvfrom(handle, datagrams[i].buffer, numeric_cast<int>(datagrams[i].capacity), 0, reinterpret_cast<sockaddr*>(datagrams[i].address.data()), &fromlen);
+
+            //on error, return the datagrams received so far; the error is reported by the next call
+            if (bytes < 0) {
+                return i > 0 ? static_cast<int>(i) : -1;
+            }
+
+            datagrams[i].size = static_cast<size_t>(bytes);
+        }
+
+        return static_cast<int>(count);
+    }
+
+
+    #endif
+
+
     //constructor
     socket::socket(int addr_family, bool reuse_addr_and_port)
         : unencrypted::socket(::socket(addr_family, SOCK_DGRAM, IPPROTO_UDP))
@@ -43,11 +140,17 @@ namespace netlib::unencrypted::udp {
 
     //Sends data to the given address.
     bool socket::send(const std::vector<char>& data, const socket_address& receiver_addr) {
+        return send(data.data(), data.size(), receiver_addr);
+    }
+
+
+    //Sends data to the given address.
+    bool socket::send(const char* data, size_t size, const socket_address& receiver_addr) {
         //sent
-        int bytes = ::sendto(handle(), data.data(), numeric_cast<int>(data.size()), 0, reinterpret_cast<const sockaddr*>(receiver_addr.data()), sizeof(sockaddr_storage));
+        int bytes = ::sendto(handle(), data, numeric_cast<int>(size), MSG_NOSIGNAL, reinterpret_cast<const sockaddr*>(receiver_addr.data()), sizeof(sockaddr_storage));
 
         //sent ok
-        if (bytes == data.size()) {
+        if (bytes == size) {
             return true;
         }
 
@@ -66,12 +169,134 @@ namespace netlib::unencrypted::udp {
         data.resize(max_message_size);
 
         //receive
-        int fromlen = sizeof(socket_address);
-        int bytes = ::recvfrom(handle(), data.data(), static_cast<int>(data.size()), 0, reinterpret_cast<sockaddr*>(sender_addr.data()), &fromlen);
+        size_t size;
+        if (!receive(data.data(), data.size(), size, sender_addr)) {
+            return false;
+        }
+
+        data.resize(size);
+        return true;
+    }
+
+
+    //Receives data from the network into the given buffer.
+    bool socket::receive(char* buffer, size_t capacity, size_t& size, socket_address& sender_addr) {
+        //receive
+        socklen_t fromlen = sizeof(socket_address);
+        int bytes = ::recvfrom(handle(), buffer, numeric_cast<int>(capacity), 0, reinterpret_cast<sockaddr*>(sender_addr.data()), &fromlen);
+
+        //receive ok
+        if (bytes >= 0) {
+            size = static_cast<size_t>(bytes);
+            return true;
+        }
+
+        //socket closed
+        if (is_socket_closed_error(get_last_error_number())) {
+            return false;
+        }
+
+        //error
+        throw std::system_error(get_last_error_number(), std::system_category());
+    }
+
+
+    //Receives data from the network into a message buffer.
+    bool socket::receive(message_buffer& data, socket_address& sender_addr, const uint16_t max_message_size) {
+        data.reserve(max_message_size);
+        size_t size;
+        if (!receive(data.data(), max_message_size, size, sender_addr)) {
+            return false;
+        }
+        data.resize(size);
+        return true;
+    }
+
+
+    //Sends multiple datagrams.
+    bool socket::send_batch(const datagram* datagrams, size_t count) {
+        while (count > 0) {
+            const int sent = send_datagrams(handle(), datagrams, count);
+
+            //sent ok; continue with the rest of the datagrams
+            if (sent >= 0) {
+                datagrams += sent;
+                count -= static_cast<size_t>(sent);
+                continue;
+            }
+
+            //socket closed
+            if (is_socket_closed_error(get_last_error_number())) {
+                return false;
+            }
+
+            //error
+            throw std::system_error(get_last_error_number(), std::system_category());
+        }
+
+        return true;
+    }
+
+
+    //Receives multiple datagrams.
+    size_t socket::receive_batch(datagram* datagrams, size_t count) {
+        //at least one slot is required
+        if (!datagrams || count == 0) {
+            throw std::invalid_argument("Invalid datagram slots.");
+        }
+
+        const int received = receive_datagrams(handle(), datagrams, count);
+
+        //receive ok
+        if (received >= 0) {
+            return static_cast<size_t>(received);
+        }
+
+        //socket closed
+        if (is_socket_closed_error(get_last_error_number())) {
+            return 0;
+        }
+
+        //error
+        throw std::system_error(get_last_error_number(), std::system_category());
+    }
+
+
+    //Enables or disables generic receive offload.
+    bool socket::set_receive_offload(bool enabled) {
+        return udp::set_receive_offload(handle(), enabled);
+    }
+
+
+    //Sends data as datagrams of the given segment size.
+    bool socket::send_segments(const char* data, size_t size, size_t segment_size, const socket_address& receiver_addr) {
+        //the segment size must not be 0
+        if (segment_size == 0) {
+            throw std::invalid_argument("Invalid segment size.");
+        }
+
+        //send ok
+        if (udp::send_segments(handle(), data, size, segment_size, &receiver_addr) >= 0) {
+            return true;
+        }
+
+        //socket closed
+        if (is_socket_closed_error(get_last_error_number())) {
+            return false;
+        }
+
+        //error
+        throw std::system_error(get_last_error_number(), std::system_category());
+    }
+
+
+    //Receives data from the network, possibly as coalesced segments.
+    bool socket::receive_segments(char* buffer, size_t capacity, size_t& size, size_t& segment_size, socket_address& sender_addr) {
+        const int bytes = udp::receive_segments(handle(), buffer, capacity, segment_size, &sender_addr);
 
         //receive ok
         if (bytes >= 0) {
-            data.resize(bytes);
+            size = static_cast<size_t>(bytes);
             return true;
         }
 
@@ -12,7 +12,17 @@
 #include "netlib/unencrypted_udp_server_socket.hpp"
 #include "netlib/unencrypted_udp_client_socket.hpp"
 #include "netlib/socket_poller_thread.hpp"
+#include "netlib/socket_poller_group.hpp"
+#include "netlib/io_engine.hpp"
+#include "netlib/async_context.hpp"
+#include "netlib/message_buffer.hpp"
+#include "netlib/unencrypted_tcp_connection_pool.hpp"
+#include "netlib/ssl_tcp_connection_pool.hpp"
 #include "netlib/ssl_tcp_server_socket.hpp"
+#include "netlib/ssl_tcp_handshake_pipeline.hpp"
+#include "netlib/ssl_engine.hpp"
+#include "netlib/ssl_udp_server_socket.hpp"
+#include "netlib/ssl_error.hpp"
 #include "netlib/numeric_cast.hpp"
 
 
@@ -372,6 +382,413 @@ static void test_tcp_sockets() {
 }
 
 
+static void test_tcp_send_batch() {
+    test("tcp send batch", [&]() {
+        const socket_address server_address(ip_address::ip4::loopback, 10000);
+
+        //messages of different sizes, including an empty one
+        std::vector<std::vector<char>> messages;
+        for (size_t i = 0; i < 10; ++i) {
+            messages.push_back(std::vector<char>(i * 100, static_cast<char>('a' + i)));
+        }
+
+        unencrypted::tcp::server_socket server(server_address);
+        unencrypted::tcp::client_socket client_socket({}, server_address);
+        socket_address client_address;
+        std::shared_ptr<unencrypted::tcp::client_socket> accepted_socket = server.accept(client_address);
+
+        //send all the messages at once; they must be received one by one
+        check(client_socket.send_batch(messages));
+        std::vector<char> buffer;
+        for (const std::vector<char>& message : messages) {
+            check(accepted_socket->receive(buffer));
+            check(buffer == message);
+        }
+        });
+}
+
+
+static void test_tcp_socket_options() {
+    test("tcp socket options", [&]() {
+        const socket_address server_address(ip_address::ip4::loopback, 10000);
+
+        const auto get_option = [](const netlib::socket& s, int level, int name) {
+            int value = 0;
+            socklen_t size = sizeof(value);
+            check(getsockopt(s.handle(), level, name, reinterpret_cast<char*>(&value), &size) == 0);
+            return value;
+        };
+
+        socket_options server_options;
+        server_options.no_delay = true;
+        server_options.keep_alive = true;
+        unencrypted::tcp::server_socket server(server_address, 0, server_options);
+
+        socket_options client_options;
+        client_options.no_delay = true;
+        client_options.receive_buffer_size = 256 * 1024;
+        client_options.keep_alive = true;
+        client_options.keep_alive_interval = std::chrono::seconds(5);
+        client_options.keep_alive_count = 3;
+        #ifdef __linux__
+        client_options.quick_ack = true;
+        client_options.keep_alive_idle = std::chrono::seconds(30);
+        client_options.user_timeout = std::chrono::milliseconds(1000);
+        client_options.not_sent_low_water_mark = 16384;
+        client_options.priority = 1;
+        #endif
+        unencrypted::tcp::client_socket client_socket({}, server_address, false, client_options);
+        socket_address client_address;
+        std::shared_ptr<unencrypted::tcp::client_socket> accepted_socket = server.accept(client_address);
+
+        check(get_option(client_socket, IPPROTO_TCP, TCP_NODELAY) != 0);
+        check(get_option(client_socket, SOL_SOCKET, SO_KEEPALIVE) != 0);
+        check(get_option(client_socket, SOL_SOCKET, SO_RCVBUF) >= 256 * 1024);
+        check(get_option(client_socket, IPPROTO_TCP, TCP_KEEPINTVL) == 5);
+        check(get_option(client_socket, IPPROTO_TCP, TCP_KEEPCNT) == 3);
+        #ifdef __linux__
+        check(get_option(client_socket, IPPROTO_TCP, TCP_KEEPIDLE) == 30);
+        check(get_option(client_socket, IPPROTO_TCP, TCP_USER_TIMEOUT) == 1000);
+        check(get_option(client_socket, IPPROTO_TCP, TCP_NOTSENT_LOWAT) == 16384);
+        check(get_option(client_socket, SOL_SOCKET, SO_PRIORITY) == 1);
+        #endif
+
+        //the accepted socket inherits the options of the server socket
+        check(get_option(*accepted_socket, IPPROTO_TCP, TCP_NODELAY) != 0);
+        check(get_option(*accepted_socket, SOL_SOCKET, SO_KEEPALIVE) != 0);
+
+        //options can be changed on connected sockets
+        #ifdef __linux__
+        socket_options cork;
+        cork.cork = true;
+        client_socket.set_options(cork);
+        check(get_option(client_socket, IPPROTO_TCP, TCP_CORK) != 0);
+        cork.cork = false;
+        client_socket.set_options(cork);
+        check(get_option(client_socket, IPPROTO_TCP, TCP_CORK) == 0);
+        #endif
+
+        std::vector<char> buffer{ 'h', 'e', 'l', 'l', 'o' };
+        check(client_socket.send(buffer));
+        std::vector<char> received;
+        check(accepted_socket->receive(received));
+        check(received == buffer);
+        });
+}
+
+
+static void test_tcp_connect_timeout() {
+    test("tcp connect timeout", [&]() {
+        const socket_address server_address(ip_address::ip4::loopback, 10000);
+
+        //the hostname resolves to all of its addresses
+        const std::vector<ip_address> localhost_addresses = ip_address::resolve("localhost");
+        check(!localhost_addresses.empty());
+        check(std::find(localhost_addresses.begin(), localhost_addresses.end(), ip_address::ip4::loopback) != localhost_addresses.end());
+        check(ip_address::resolve("127.0.0.1") == std::vector<ip_address>{ ip_address::ip4::loopback });
+
+        //connect by hostname; the server listens on ip4 only, so an ip6 attempt, if any, fails over to ip4
+        unencrypted::tcp::server_socket server(server_address, 1);
+        unencrypted::tcp::client_socket client_socket("localhost", server_address.port(), std::chrono::seconds(5));
+        socket_address client_address;
+        auto accepted_socket = server.accept(client_address);
+        check(client_socket.peer_address() == server_address);
+        std::vector<char> buffer{ 'h', 'e', 'l', 'l', 'o' };
+        check(client_socket.send(buffer));
+        std::vector<char> received;
+        check(accepted_socket->receive(received));
+        check(received == buffer);
+
+        //refused connections fail without waiting for the timeout
+        {
+            const socket_address closed_address(ip_address::ip4::loopback, server_address.port() + 1);
+            const auto start = std::chrono::steady_clock::now();
+            try {
+                unencrypted::tcp::client_socket refused_socket(std::nullopt, closed_address, std::chrono::seconds(5));
+                check(false);
+            }
+            catch (const std::system_error& ex) {
+                check(ex.code().value() != get_connection_timeout_error_number());
+            }
+            check(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+        }
+
+        //fill the accept queue of the server, so as that further connections are not answered
+        std::vector<std::shared_ptr<unencrypted::tcp::client_socket>> queued_sockets;
+        for (size_t i = 0; i < 8; ++i) {
+            try {
+                queued_sockets.push_back(std::make_shared<unencrypted::tcp::client_socket>(std::nullopt, server_address, std::chrono::milliseconds(100)));
+            }
+            catch (const std::system_error&) {
+                break;
+            }
+        }
+
+        //an unanswered connection times out
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            unencrypted::tcp::client_socket timeout_socket(std::nullopt, server_address, std::chrono::milliseconds(200));
+            check(false);
+        }
+        catch (const std::system_error& ex) {
+            check(ex.code().value() == get_connection_timeout_error_number());
+        }
+        check(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+        });
+
+    test("ssl tcp connect timeout", [&]() {
+        const socket_address server_address(ip_address::ip4::loopback, 10002);
+        ssl::tcp::server_context server_context("netlib.pem", "netlib.key");
+        ssl::tcp::client_context client_context("netlib.pem", "netlib.key");
+        ssl::tcp::server_socket server(server_context, server_address);
+
+        std::thread server_thread([&]() {
+            try {
+                socket_address client_address;
+                auto accepted_socket = server.accept(client_address);
+                std::vector<char> received;
+                if (accepted_socket->receive(received)) {
+                    accepted_socket->send(received);
+                }
+            }
+            catch (const std::exception& ex) {
+                fail_test_with_exception(ex);
+            }
+            });
+
+        //the connection is closed before joining, since the server waits for the close notification
+        {
+            ssl::tcp::client_socket client_socket(client_context, "localhost", server_address.port(), std::chrono::seconds(5));
+            std::vector<char> buffer{ 'h', 'e', 'l', 'l', 'o' };
+            check(client_socket.send(buffer));
+            std::vector<char> received;
+            check(client_socket.receive(received));
+            check(received == buffer);
+        }
+        server_thread.join();
+
+        //a server that does not answer the handshake times out
+        unencrypted::tcp::server_socket silent_server(socket_address(ip_address::ip4::loopback, server_address.port() + 1));
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            ssl::tcp::client_socket timeout_socket(client_context, std::nullopt, silent_server.bound_address(), std::chrono::milliseconds(200));
+            check(false);
+        }
+        catch (const std::system_error& ex) {
+            check(ex.code().value() == get_connection_timeout_error_number());
+        }
+        check(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+        });
+}
+
+
+static void test_connection_pool() {
+    test("tcp connection pool", [&]() {
+        const socket_address server_address(ip_address::ip4::loopback, 10000);
+        unencrypted::tcp::server_socket server(server_address);
+        socket_address client_address;
+
+        connection_pool_options options;
+        options.max_idle = 1;
+        options.max_total = 2;
+        options.idle_timeout = std::chrono::milliseconds(300);
+        options.connect_timeout = std::chrono::milliseconds(200);
+        unencrypted::tcp::connection_pool pool(options);
+
+        //a released connection is reused
+        auto connection1 = pool.acquire(server_address);
+        auto accepted_socket1 = server.accept(client_address);
+        unencrypted::tcp::client_socket* const connection1_ptr = connection1.get();
+        connection1.reset();
+        check(pool.idle_count() == 1);
+        auto connection2 = pool.acquire(server_address);
+        check(connection2.get() == connection1_ptr);
+        check(pool.idle_count() == 0);
+        check(pool.connection_count() == 1);
+
+        //a new connection is created when there is no idle one
+        auto connection3 = pool.acquire(server_address);
+        auto accepted_socket3 = server.accept(client_address);
+        check(connection3.get() != connection1_ptr);
+        check(pool.connection_count() == 2);
+
+        //the max number of connections is reached; acquiring times out
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            pool.acquire(server_address);
+            check(false);
+        }
+        catch (const std::system_error& ex) {
+            check(ex.code().value() == get_connection_timeout_error_number());
+        }
+        check(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+
+        //connections beyond the idle limit are closed when released
+        connection2.reset();
+        connection3.reset();
+        check(pool.idle_count() == 1);
+        check(pool.connection_count() == 1);
+
+        //a connection closed by the server is not reused
+        accepted_socket1.reset();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        auto connection4 = pool.acquire(server_address);
+        auto accepted_socket4 = server.accept(client_address);
+        check(pool.connection_count() == 1);
+        std::vector<char> buffer{ 'h', 'e', 'l', 'l', 'o' };
+        check(connection4->send(buffer));
+        std::vector<char> received;
+        check(accepted_socket4->receive(received));
+        check(received == buffer);
+
+        //idle connections are closed after the idle timeout
+        connection4.reset();
+        check(pool.idle_count() == 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(400));
+        pool.evict_idle();
+        check(pool.idle_count() == 0);
+        check(pool.connection_count() == 0);
+
+        //discarded connections are not reused
+        auto connection5 = pool.acquire(server_address);
+        auto accepted_socket5 = server.accept(client_address);
+        pool.discard(connection5);
+        connection5.reset();
+        check(pool.idle_count() == 0);
+        check(pool.connection_count() == 0);
+        });
+
+    test("tcp connection pool keys", [&]() {
+        const socket_address server_address_a(ip_address::ip4::loopback, 10001);
+        const socket_address server_address_b(ip_address::ip4::loopback, 10002);
+        unencrypted::tcp::server_socket server_a(server_address_a);
+        unencrypted::tcp::server_socket server_b(server_address_b);
+        socket_address client_address;
+
+        connection_pool_options options;
+        options.max_idle = 1;
+        options.max_total = 1;
+        options.connect_timeout = std::chrono::milliseconds(2000);
+        unencrypted::tcp::connection_pool pool(options);
+
+        //both keys are at the max number of connections
+        auto connection_a = pool.acquire(server_address_a);
+        auto accepted_socket_a = server_a.accept(client_address);
+        auto connection_b = pool.acquire(server_address_b);
+        auto accepted_socket_b = server_b.accept(client_address);
+
+        //the waiters of both keys wait for a connection
+        std::shared_ptr<unencrypted::tcp::client_socket> waited_a, waited_b;
+        std::thread waiter_b([&]() {
+            try {
+                waited_b = pool.acquire(server_address_b);
+            }
+            catch (const std::exception& ex) {
+                fail_test_with_exception(ex);
+            }
+            });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        std::thread waiter_a([&]() {
+            try {
+                waited_a = pool.acquire(server_address_a);
+            }
+            catch (const std::exception& ex) {
+                fail_test_with_exception(ex);
+            }
+            });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        //a connection returned for one key is taken by the waiter of that key, not lost to the other waiter
+        unencrypted::tcp::client_socket* const connection_a_ptr = connection_a.get();
+        const auto start = std::chrono::steady_clock::now();
+        connection_a.reset();
+        waiter_a.join();
+        check(waited_a.get() == connection_a_ptr);
+        check(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+
+        connection_b.reset();
+        waiter_b.join();
+        check(waited_b != nullptr);
+        });
+
+    test("ssl tcp connection pool", [&]() {
+        const socket_address server_address(ip_address::ip4::loopback, 10003);
+        ssl::tcp::server_context server_context("netlib.pem", "netlib.key");
+        ssl::tcp::client_context client_context("netlib.pem", "netlib.key");
+        ssl::tcp::server_socket server(server_context, server_address);
+        std::atomic<size_t> accept_count{ 0 };
+
+        std::thread server_thread([&]() {
+            try {
+                socket_address client_address;
+                auto accepted_socket = server.accept(client_address);
+                ++accept_count;
+                std::vector<char> received;
+                while (accepted_socket->receive(received)) {
+                    accepted_socket->send(received);
+                }
+            }
+            catch (const std::exception& ex) {
+                fail_test_with_exception(ex);
+            }
+            });
+
+        //the pool is destroyed before joining, since the server waits for the close notification
+        {
+            ssl::tcp::connection_pool pool;
+            std::vector<char> buffer{ 'h', 'e', 'l', 'l', 'o' };
+            std::vector<char> received;
+
+            auto connection1 = pool.acquire(client_context, server_address);
+            check(connection1->send(buffer));
+            check(connection1->receive(received));
+            check(received == buffer);
+            ssl::tcp::client_socket* const connection1_ptr = connection1.get();
+            connection1.reset();
+
+            //the connection is reused without a new handshake
+            auto connection2 = pool.acquire(client_context, server_address);
+            check(connection2.get() == connection1_ptr);
+            check(connection2->send(buffer));
+            check(connection2->receive(received));
+            check(received == buffer);
+            check(accept_count == 1);
+        }
+        server_thread.join();
+        });
+}
+
+static void test_tcp_buffered_receive() {
+    test("tcp buffered receive", [&]() {
+        const socket_address server_address(ip_address::ip4::loopback, 10000);
+        const std::vector<std::vector<char>> messages(10, std::vector<char>{'h', 'e', 'l', 'l', 'o'});
+
+        unencrypted::tcp::server_socket server(server_address);
+        unencrypted::tcp::client_socket client_socket({}, server_address);
+        socket_address client_address;
+        std::shared_ptr<unencrypted::tcp::client_socket> accepted_socket = server.accept(client_address);
+        check(client_socket.send_batch(messages));
+
+        //wait for all the messages to arrive
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        //the callback receives one message each time; the rest of the messages are in the receive buffer,
+        //so the poller must invoke the callback for them too
+        socket_poller poller;
+        size_t message_count{};
+        poller.add(accepted_socket, [&](socket_poller& sp, const std::shared_ptr<unencrypted::tcp::client_socket>& s, socket_poller::event_type e, socket_poller::status_flags f) {
+            std::vector<char> buffer;
+            check(s->receive(buffer));
+            check(buffer == messages[message_count]);
+            ++message_count;
+            });
+        check(poller.poll(1000) == socket_poller::poll_status::success);
+        check(message_count == messages.size());
+        check(accepted_socket->buffered_receive_size() == 0);
+        });
+}
+
+
 static void test_tcp_socket_polling() {
     test("tcp socket polling", [&]() {
         static constexpr size_t server_socket_count = 10;
@@ -549,6 +966,213 @@ static void test_udp_sockets() {
 }
 
 
+static void test_udp_receive_into_buffer() {
+    socket_address server_address(ip_address::ip4::loopback, 10000);
+    const std::string message = "hello world!";
+
+    test("udp receive into buffer", [&]() {
+        unencrypted::udp::server_socket server(server_address);
+        unencrypted::udp::socket client_socket(ip_address::ip4);
+        const std::vector<char> data(message.begin(), message.end());
+        socket_address sender_addr;
+        size_t size;
+
+        //caller-provided buffer
+        char buffer[64];
+        client_socket.send(data, server_address);
+        check(server.receive(buffer, sizeof(buffer), size, sender_addr));
+        check(std::string(buffer, size) == message);
+
+        //truncated datagram
+        client_socket.send(data, server_address);
+        check(server.receive(buffer, 5, size, sender_addr));
+        check(size == 5 && std::string(buffer, size) == message.substr(0, 5));
+
+        //pooled buffer; its memory is reused after it is released
+        message_buffer pooled;
+        client_socket.send(data, server_address);
+        check(server.receive(pooled, sender_addr, 64));
+        check(std::string(pooled.data(), pooled.size()) == message);
+        const char* const pooled_data = pooled.data();
+        pooled.reset();
+        message_buffer reused(64);
+        check(reused.data() == pooled_data);
+        });
+}
+
+static void test_message_buffer() {
+    test("message buffer", [&]() {
+        //the capacity is rounded up to the size class
+        message_buffer buffer(100);
+        check(buffer.capacity() == 128);
+        check(buffer.size() == 0);
+        check(buffer.use_count() == 1);
+        try {
+            buffer.resize(129);
+            check(false);
+        }
+        catch (const std::length_error&) {
+        }
+
+        //copies share the memory
+        buffer.resize(5);
+        message_buffer copy = buffer;
+        check(copy.data() == buffer.data() && copy.size() == 5);
+        check(buffer.use_count() == 2);
+        copy.reset();
+        check(buffer.use_count() == 1);
+
+        //released memory is reused by the thread
+        const char* const data = buffer.data();
+        buffer.reset();
+        check(!buffer);
+        buffer.resize(0);
+        check(buffer.size() == 0);
+        message_buffer reused(120);
+        check(reused.data() == data);
+
+        //an unshared buffer with enough capacity is kept; a shared one is replaced
+        reused.reserve(64);
+        check(reused.data() == data && reused.size() == 0);
+        copy = reused;
+        reused.reserve(64);
+        check(reused.data() != data && copy.data() == data);
+
+        //large buffers have the requested capacity
+        message_buffer large(NETLIB_MESSAGE_BUFFER_MAX_CAPACITY + 1);
+        check(large.capacity() == NETLIB_MESSAGE_BUFFER_MAX_CAPACITY + 1);
+
+        //buffers can be released by other threads
+        message_buffer other_thread_buffer;
+        std::thread([&]() { other_thread_buffer = message_buffer(1000); }).join();
+        check(other_thread_buffer.capacity() == 1024);
+        other_thread_buffer.reset();
+        });
+
+    test("tcp message buffer", [&]() {
+        const socket_address server_address(ip_address::ip4::loopback, 10000);
+        const std::string message = "hello world!";
+        unencrypted::tcp::server_socket server(server_address);
+        unencrypted::tcp::client_socket client_socket(std::nullopt, server_address);
+        socket_address client_address;
+        auto accepted_socket = server.accept(client_address);
+
+        message_buffer sent(message.size());
+        sent.resize(message.size());
+        std::copy(message.begin(), message.end(), sent.data());
+
+        //the reception buffer is reused for the next messages
+        message_buffer received;
+        check(client_socket.send(sent));
+        check(accepted_socket->receive(received));
+        check(std::string(received.data(), received.size()) == message);
+        const char* const data = received.data();
+        check(client_socket.send(sent));
+        check(accepted_socket->receive(received));
+        check(received.data() == data);
+        check(std::string(received.data(), received.size()) == message);
+
+        //a received buffer can be sent as is
+        check(accepted_socket->send(received));
+        message_buffer echoed;
+        check(client_socket.receive(echoed));
+        check(std::string(echoed.data(), echoed.size()) == message);
+        });
+
+    test("udp message buffer", [&]() {
+        const socket_address server_address(ip_address::ip4::loopback, 10000);
+        const std::string message = "hello world!";
+        unencrypted::udp::server_socket server(server_address);
+        unencrypted::udp::socket client_socket(ip_address::ip4);
+        socket_address sender_addr;
+
+        message_buffer sent(message.size());
+        sent.resize(message.size());
+        std::copy(message.begin(), message.end(), sent.data());
+
+        message_buffer received;
+        check(client_socket.send(sent, server_address));
+        check(server.receive(received, sender_addr, 64));
+        check(received.capacity() == 64);
+        check(std::string(received.data(), received.size()) == message);
+        });
+}
+
+
+
+static void test_udp_batch() {
+    socket_address server_address(ip_address::ip4::loopback, 10000);
+    static constexpr size_t message_count = 100;
+
+    test("udp batch", [&]() {
+        unencrypted::udp::server_socket server(server_address);
+        unencrypted::udp::socket client_socket(ip_address::ip4);
+
+        //send the messages in one batch
+        std::vector<std::string> messages;
+        std::vector<unencrypted::udp::datagram> send_datagrams(message_count);
+        for (size_t i = 0; i < message_count; ++i) {
+            messages.push_back("message " + std::to_string(i));
+        }
+        for (size_t i = 0; i < message_count; ++i) {
+            send_datagrams[i].buffer = messages[i].data();
+            send_datagrams[i].size = messages[i].size();
+            send_datagrams[i].address = server_address;
+        }
+        check(client_socket.send_batch(send_datagrams.data(), send_datagrams.size()));
+
+        //receive the messages in batches
+        std::vector<std::array<char, 64>> buffers(message_count);
+        std::vector<unencrypted::udp::datagram> receive_datagrams(message_count);
+        for (size_t i = 0; i < message_count; ++i) {
+            receive_datagrams[i].buffer = buffers[i].data();
+            receive_datagrams[i].capacity = buffers[i].size();
+        }
+        size_t received = 0;
+        while (received < message_count) {
+            const size_t count = server.receive_batch(receive_datagrams.data() + received, message_count - received);
+            check(count > 0);
+            received += count;
+        }
+        for (size_t i = 0; i < message_count; ++i) {
+            check(std::string(receive_datagrams[i].buffer, receive_datagrams[i].size) == messages[i]);
+        }
+        });
+}
+
+
+static void test_udp_segmentation_offload() {
+    socket_address server_address(ip_address::ip4::loopback, 10000);
+    static constexpr size_t segment_size = 1000;
+
+    test("udp segmentation offload", [&]() {
+        unencrypted::udp::server_socket server(server_address);
+        server.set_receive_offload(true);
+        unencrypted::udp::socket client_socket(ip_address::ip4);
+
+        //send 20.5 segments
+        std::vector<char> data(segment_size * 20 + segment_size / 2);
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = static_cast<char>(i / segment_size);
+        }
+        check(client_socket.send_segments(data.data(), data.size(), segment_size, server_address));
+
+        //receive the segments, possibly coalesced
+        std::vector<char> buffer(NETLIB_UDP_MAX_MESSAGE_SIZE);
+        socket_address sender_addr;
+        size_t total_size = 0;
+        while (total_size < data.size()) {
+            size_t size, received_segment_size;
+            check(server.receive_segments(buffer.data(), buffer.size(), size, received_segment_size, sender_addr));
+            check(size <= segment_size || received_segment_size == segment_size);
+            check(std::equal(buffer.begin(), buffer.begin() + size, data.begin() + total_size));
+            total_size += size;
+        }
+        check(total_size == data.size());
+        });
+}
+
+
 static void test_udp_socket_polling() {
     test("udp socket polling", [&]() {
         static constexpr size_t server_socket_count = 10;
@@ -677,6 +1301,338 @@ static void test_udp_socket_polling() {
 }
 
 
+static void test_socket_poller_one_shot() {
+    test("socket poller one-shot", [&]() {
+        const socket_address server_address(ip_address::ip4::loopback, 10000);
+        const std::string message = "hello server!!!";
+
+        socket_poller poller;
+        size_t callback_count{};
+
+        //add the server socket in one-shot mode; the data are not read, so level-triggered mode would report them repeatedly
+        auto server_socket = std::make_shared<unencrypted::udp::server_socket>(server_address);
+        poller.add(server_socket, [&](socket_poller& sp, const std::shared_ptr<unencrypted::udp::server_socket>& s, socket_poller::event_type e, socket_poller::status_flags f) {
+            ++callback_count;
+            }, socket_poller::registration_mode::one_shot);
+
+        //send a message
+        unencrypted::udp::socket client_socket(ip_address::ip4);
+        check(client_socket.send(std::vector<char>(message.begin(), message.end()), server_address));
+
+        //the socket must be reported once
+        check(poller.poll(1000) == socket_poller::poll_status::success);
+        check(poller.poll(10) == socket_poller::poll_status::timeout);
+        check(callback_count == 1);
+
+        //after re-arming, the socket must be reported once again
+        poller.rearm(server_socket);
+        check(poller.poll(1000) == socket_poller::poll_status::success);
+        check(poller.poll(10) == socket_poller::poll_status::timeout);
+        check(callback_count == 2);
+        });
+}
+
+static void test_socket_poller_callbacks() {
+    test("callback", [&]() {
+        //move-only function objects
+        auto value = std::make_unique<int>(1);
+        callback<int(int)> small_callback([value = std::move(value)](int x) { return x + *value; });
+        check(small_callback(1) == 2);
+
+        //function objects larger than the buffer
+        std::array<char, NETLIB_CALLBACK_BUFFER_SIZE * 2> large_data{};
+        large_data[0] = 2;
+        callback<int(int)> large_callback([large_data](int x) { return x + large_data[0]; });
+        check(large_callback(1) == 3);
+
+        //moving transfers the function object
+        callback<int(int)> moved_callback = std::move(large_callback);
+        check(!large_callback);
+        check(moved_callback(1) == 3);
+
+        //function objects are destroyed once
+        auto counter = std::make_shared<int>(0);
+        {
+            callback<void()> c([counter]() {});
+            callback<void()> c1 = std::move(c);
+            check(counter.use_count() == 2);
+        }
+        check(counter.use_count() == 1);
+
+        //an empty std::function gives an empty callback
+        check(!callback<void()>(std::function<void()>()));
+        });
+
+    test("socket poller callbacks", [&]() {
+        const socket_address server_address(ip_address::ip4::loopback, 10000);
+        const std::string message = "hello server!!!";
+
+        socket_poller poller;
+        size_t callback_count{};
+
+        //the callback removes its own entry
+        auto server_socket = std::make_shared<unencrypted::udp::server_socket>(server_address);
+        poller.add(server_socket, [&](socket_poller& sp, const std::shared_ptr<unencrypted::udp::server_socket>& s, socket_poller::event_type e, socket_poller::status_flags f) {
+            ++callback_count;
+            std::vector<char> data;
+            socket_address sender_addr;
+            s->receive(data, sender_addr);
+            sp.remove(s);
+            });
+        check(server_socket.use_count() > 1);
+
+        unencrypted::udp::socket client_socket(ip_address::ip4);
+        check(client_socket.send(std::vector<char>(message.begin(), message.end()), server_address));
+        check(poller.poll(1000) == socket_poller::poll_status::success);
+        check(callback_count == 1);
+
+        //the entry is released once the events are dispatched
+        check(server_socket.use_count() == 1);
+        check(poller.entry_count() == 0);
+        });
+}
+
+
+
+static void test_socket_poller_group() {
+    test("socket poller group", [&]() {
+        static constexpr size_t socket_count = 8;
+        const std::string message = "hello server!!!";
+
+        socket_poller_group group(4, socket_poller_group::distribution_policy::least_loaded);
+        std::atomic<size_t> receive_count{};
+
+        //add the server sockets; they must be spread evenly over the threads
+        std::vector<std::shared_ptr<unencrypted::udp::server_socket>> server_sockets;
+        for (size_t i = 0; i < socket_count; ++i) {
+            auto server_socket = std::make_shared<unencrypted::udp::server_socket>(socket_address(ip_address::ip4::loopback, numeric_cast<uint16_t>(10000 + i)));
+            group.add(server_socket, [&](socket_poller& sp, const std::shared_ptr<unencrypted::udp::server_socket>& s, socket_poller::event_type e, socket_poller::status_flags f) {
+                std::vector<char> buffer;
+                socket_address address;
+                s->receive(buffer, address);
+                ++receive_count;
+                });
+            server_sockets.push_back(server_socket);
+        }
+        for (size_t i = 0; i < group.size(); ++i) {
+            check(group.poller(i).entry_count() == socket_count / group.size());
+        }
+
+        //send a message to each server socket
+        unencrypted::udp::socket client_socket(ip_address::ip4);
+        for (size_t i = 0; i < socket_count; ++i) {
+            check(client_socket.send(std::vector<char>(message.begin(), message.end()), socket_address(ip_address::ip4::loopback, numeric_cast<uint16_t>(10000 + i))));
+        }
+
+        //wait for the messages
+        for (size_t i = 0; i < 100 && receive_count < socket_count; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        check(receive_count == socket_count);
+
+        //remove the sockets
+        for (const auto& server_socket : server_sockets) {
+            group.remove(server_socket);
+        }
+        for (size_t i = 0; i < group.size(); ++i) {
+            check(group.poller(i).entry_count() == 0);
+        }
+        });
+}
+
+
+static void test_io_engine() {
+    test("io engine", [&]() {
+        const socket_address server_address(ip_address::ip4::loopback, 10000);
+        const std::string message = "hello server!!!";
+
+        io_engine engine;
+
+        //accept and connect
+        auto server_socket = std::make_shared<unencrypted::tcp::server_socket>(server_address);
+        std::shared_ptr<unencrypted::tcp::client_socket> accepted_socket, connected_socket;
+        engine.accept(server_socket, [&](io_engine& e, const io_engine::completion& c) {
+            check(c.error_number == 0);
+            accepted_socket = c.client_socket;
+            });
+        engine.connect(server_address, [&](io_engine& e, const io_engine::completion& c) {
+            check(c.error_number == 0);
+            connected_socket = c.client_socket;
+            });
+        while (!accepted_socket || !connected_socket) {
+            check(engine.poll(1000) == io_engine::poll_status::success);
+        }
+
+        //send and receive in one batch
+        std::vector<char> buffer(message.size());
+        size_t bytes_sent{}, bytes_received{};
+        engine.receive(accepted_socket, buffer.data(), buffer.size(), [&](io_engine& e, const io_engine::completion& c) {
+            bytes_received += c.bytes;
+            });
+        engine.send(connected_socket, message.data(), message.size(), [&](io_engine& e, const io_engine::completion& c) {
+            bytes_sent += c.bytes;
+            });
+        while (bytes_sent < message.size() || bytes_received < message.size()) {
+            check(engine.poll(1000) == io_engine::poll_status::success);
+        }
+        check(std::string(buffer.begin(), buffer.end()) == message);
+
+        //nothing else to complete
+        check(engine.poll(10) == io_engine::poll_status::timeout);
+        });
+}
+
+
+//connects an unencrypted tcp client socket
+static task<std::shared_ptr<unencrypted::tcp::client_socket>> async_connect(async_context& context, socket_address server_addr) {
+    co_return co_await context.connect(server_addr);
+}
+
+
+//connects an ssl tcp client socket
+static task<std::shared_ptr<ssl::tcp::client_socket>> async_connect(async_context& context, const ssl::tcp::client_context& ssl_context, socket_address server_addr) {
+    co_return co_await context.connect(ssl_context, server_addr);
+}
+
+
+//accepts a connection, then echoes the received messages until the connection is closed
+template <class Server> static task<> async_echo_server(async_context& context, std::shared_ptr<Server> server, std::atomic<size_t>& done_count) {
+    try {
+        socket_address addr;
+        auto client = co_await context.accept(server, addr);
+        std::vector<char> data;
+        while (co_await context.receive(client, data)) {
+            co_await context.send(client, data);
+        }
+        context.remove(client);
+        ++done_count;
+    }
+    catch (const std::exception& ex) {
+        fail_test_with_exception(ex);
+    }
+}
+
+
+//sends messages, and checks that they are echoed
+template <class Client> static task<> async_echo_client(async_context& context, task<std::shared_ptr<Client>> connection, std::atomic<size_t>& done_count) {
+    try {
+        auto s = co_await std::move(connection);
+        std::vector<char> received;
+        bool echoed = true;
+        for (size_t i = 0; i < 10; ++i) {
+            const std::vector<char> data(100 + i * 1000, static_cast<char>('a' + i));
+            echoed = echoed && co_await context.send(s, data) && co_await context.receive(s, received) && received == data;
+        }
+        context.remove(s);
+        if (echoed) {
+            ++done_count;
+        }
+    }
+    catch (const std::exception& ex) {
+        fail_test_with_exception(ex);
+    }
+}
+
+
+//echoes datagrams
+static task<> async_udp_echo_server(async_context& context, std::shared_ptr<unencrypted::udp::socket> s, std::atomic<size_t>& done_count) {
+    try {
+        std::vector<char> data;
+        socket_address sender_address;
+        for (size_t i = 0; i < 10; ++i) {
+            co_await context.receive_from(s, data, sender_address);
+            co_await context.send_to(s, data, sender_address);
+        }
+        context.remove(s);
+        ++done_count;
+    }
+    catch (const std::exception& ex) {
+        fail_test_with_exception(ex);
+    }
+}
+
+
+//sends datagrams, and checks that they are echoed
+static task<> async_udp_echo_client(async_context& context, std::shared_ptr<unencrypted::udp::client_socket> s, std::atomic<size_t>& done_count) {
+    try {
+        std::vector<char> received;
+        bool echoed = true;
+        for (size_t i = 0; i < 10; ++i) {
+            const std::vector<char> data(100 + i * 100, static_cast<char>('a' + i));
+            echoed = echoed && co_await context.send(s, data) && co_await context.receive(s, received) && received == data;
+        }
+        context.remove(s);
+        if (echoed) {
+            ++done_count;
+        }
+    }
+    catch (const std::exception& ex) {
+        fail_test_with_exception(ex);
+    }
+}
+
+
+static void test_async_context() {
+    const socket_address server_address(ip_address::ip4::loopback, 10000);
+    const socket_address ssl_server_address(ip_address::ip4::loopback, 10001);
+    const socket_address udp_server_address(ip_address::ip4::loopback, 10002);
+    const socket_address udp_client_address(ip_address::ip4::loopback, 10003);
+    const socket_address stalled_server_address(ip_address::ip4::loopback, 10004);
+
+    test("async context", [&]() {
+        socket_poller_thread poller;
+        std::atomic<size_t> done_count{ 0 };
+
+        {
+            async_context context(poller);
+
+            //unencrypted tcp
+            auto server = std::make_shared<unencrypted::tcp::server_socket>(server_address);
+            async_echo_server(context, server, done_count).start();
+            async_echo_client(context, async_connect(context, server_address), done_count).start();
+
+            //ssl tcp
+            ssl::tcp::server_context server_context("netlib.pem", "netlib.key");
+            ssl::tcp::client_context client_context("netlib.pem", "netlib.key");
+            auto ssl_server = std::make_shared<ssl::tcp::server_socket>(server_context, ssl_server_address);
+            async_echo_server(context, ssl_server, done_count).start();
+            async_echo_client(context, async_connect(context, client_context, ssl_server_address), done_count).start();
+
+            //udp
+            auto udp_server = std::make_shared<unencrypted::udp::socket>(udp_server_address);
+            auto udp_client = std::make_shared<unencrypted::udp::client_socket>(udp_client_address, udp_server_address);
+            async_udp_echo_server(context, udp_server, done_count).start();
+            async_udp_echo_client(context, udp_client, done_count).start();
+
+            //a peer that sends part of a message does not block the operations of the other sockets
+            auto stalled_server = std::make_shared<unencrypted::tcp::server_socket>(stalled_server_address);
+            async_echo_server(context, stalled_server, done_count).start();
+            auto stalled_client = std::make_unique<unencrypted::tcp::client_socket>(std::nullopt, stalled_server_address);
+            const char partial_message[] = { 0, 100, 'a' };
+            ::send(stalled_client->handle(), partial_message, sizeof(partial_message), 0);
+
+            for (size_t i = 0; i < 1000 && done_count < 6; ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            check(done_count == 6);
+
+            //closing the stalled connection completes its echo server
+            stalled_client.reset();
+            for (size_t i = 0; i < 1000 && done_count < 7; ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            check(done_count == 7);
+
+            context.remove(server);
+            context.remove(ssl_server);
+            context.remove(stalled_server);
+        }
+
+        check(poller.entry_count() == 0);
+        });
+}
+
+
 static void test_ssl_tcp_sockets() {
     socket_address server_address(ip_address::ip4::loopback, 10000);
     const std::string message = "hello world!";
@@ -721,6 +1677,486 @@ static void test_ssl_tcp_sockets() {
 }
 
 
+static void test_ssl_tcp_send_batch() {
+    test("ssl tcp send batch", [&]() {
+        const socket_address server_address(ip_address::ip4::loopback, 10000);
+
+        //many small messages, an empty one, and one larger than a tls record
+        std::vector<std::vector<char>> messages;
+        for (size_t i = 0; i < 100; ++i) {
+            messages.push_back(std::vector<char>(i % 10 * 10, static_cast<char>('a' + i % 26)));
+        }
+        messages.push_back(std::vector<char>(40000, 'z'));
+        messages.push_back(std::vector<char>{'e', 'n', 'd'});
+
+        std::thread server_thread([&]() {
+            try {
+                ssl::tcp::server_context context("netlib.pem", "netlib.key");
+                ssl::tcp::server_socket server(context, server_address);
+                socket_address client_address;
+                std::shared_ptr<ssl::tcp::client_socket> client_socket = server.accept(client_address);
+
+                //the messages must be received one by one
+                std::vector<char> buffer;
+                for (const std::vector<char>& message : messages) {
+                    check(client_socket->receive(buffer));
+                    check(buffer == message);
+                }
+                client_socket->send(buffer);
+            }
+            catch (const std::exception& ex) {
+                fail_test_with_exception(ex);
+            }
+            });
+
+        std::thread client_thread([&]() {
+            try {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                ssl::tcp::client_context context("netlib.pem", "netlib.key");
+                ssl::tcp::client_socket client_socket(context, {}, server_address);
+                check(client_socket.send_batch(messages));
+                std::vector<char> buffer;
+                check(client_socket.receive(buffer));
+                check(buffer == messages.back());
+            }
+            catch (const std::exception& ex) {
+                fail_test_with_exception(ex);
+            }
+            });
+
+        server_thread.join();
+        client_thread.join();
+        });
+}
+
+
+static void test_ssl_tcp_non_blocking() {
+    socket_address server_address(ip_address::ip4::loopback, 10000);
+
+    test("ssl tcp non-blocking", [&]() {
+        ssl::tcp::server_context server_context("netlib.pem", "netlib.key");
+        ssl::tcp::server_socket server(server_context, server_address);
+        ssl::tcp::client_context client_context("netlib.pem", "netlib.key");
+
+        //both sides are driven from this thread
+        ssl::tcp::client_socket client_socket(client_context, {}, server_address, false, true);
+        socket_address client_address;
+        std::shared_ptr<ssl::tcp::client_socket> server_client_socket = server.accept(client_address, true);
+
+        //handshake
+        bool client_done = false, server_done = false;
+        while (!client_done || !server_done) {
+            if (!client_done) {
+                const ssl::io_status status = client_socket.handshake();
+                check(status != ssl::io_status::closed);
+                client_done = status == ssl::io_status::done;
+            }
+            if (!server_done) {
+                const ssl::io_status status = server_client_socket->handshake();
+                check(status != ssl::io_status::closed);
+                server_done = status == ssl::io_status::done;
+            }
+        }
+
+        //send more data than what fits in the socket buffers, then small messages
+        std::vector<std::vector<char>> messages;
+        for (size_t i = 0; i < 100; ++i) {
+            messages.push_back(std::vector<char>(60000, static_cast<char>('a' + i % 26)));
+        }
+        for (size_t i = 0; i < 100; ++i) {
+            const std::string str = "message " + std::to_string(i);
+            messages.push_back(std::vector<char>(str.begin(), str.end()));
+        }
+        for (const std::vector<char>& message : messages) {
+            client_socket.send_non_blocking(message);
+        }
+
+        //receive the messages, while sending the pending data
+        std::vector<char> buffer;
+        for (size_t received = 0; received < messages.size(); ) {
+            check(client_socket.flush() != ssl::io_status::closed);
+            const ssl::io_status status = server_client_socket->receive_non_blocking(buffer);
+            check(status != ssl::io_status::closed);
+            if (status == ssl::io_status::done) {
+                check(buffer == messages[received]);
+                ++received;
+            }
+        }
+        check(client_socket.pending_send_size() == 0);
+
+        //nothing else to receive
+        check(server_client_socket->receive_non_blocking(buffer) == ssl::io_status::want_read);
+
+        //shutdown
+        client_done = server_done = false;
+        while (!client_done || !server_done) {
+            if (!client_done) {
+                client_done = client_socket.shutdown() == ssl::io_status::done;
+            }
+            if (!server_done) {
+                server_done = server_client_socket->shutdown() == ssl::io_status::done;
+            }
+        }
+        });
+}
+
+
+static void test_ssl_tcp_session_resumption() {
+    socket_address server_address(ip_address::ip4::loopback, 10000);
+    const std::string message = "hello world!";
+    static constexpr size_t connection_count = 3;
+
+    test("ssl tcp session resumption", [&]() {
+        std::thread server_thread([&]() {
+            try {
+                ssl::tcp::server_context context("netlib.pem", "netlib.key");
+                ssl::tcp::server_socket server(context, server_address);
+                for (size_t i = 0; i < connection_count; ++i) {
+                    //tickets of previous connections become invalid
+                    if (i == connection_count - 1) {
+                        context.rotate_ticket_keys();
+                        context.rotate_ticket_keys();
+                    }
+                    socket_address client_address;
+                    std::shared_ptr<ssl::tcp::client_socket> client_socket = server.accept(client_address);
+                    std::vector<char> buffer(message.begin(), message.end());
+                    client_socket->send(buffer);
+                    client_socket->receive(buffer);
+                }
+            }
+            catch (const std::exception& ex) {
+                fail_test_with_exception(ex);
+            }
+            });
+
+        std::thread client_thread([&]() {
+            try {
+                ssl::tcp::client_context context("netlib.pem", "netlib.key");
+                for (size_t i = 0; i < connection_count; ++i) {
+                    ssl::tcp::client_socket client_socket(context, {}, server_address, "localhost");
+                    check(client_socket.is_session_reused() == (i == 1));
+
+                    //the session is stored after the session ticket is received
+                    std::vector<char> buffer;
+                    client_socket.receive(buffer);
+                    check(context.session_count() == 1);
+                    client_socket.send(buffer);
+                }
+            }
+            catch (const std::exception& ex) {
+                fail_test_with_exception(ex);
+            }
+            });
+
+        server_thread.join();
+        client_thread.join();
+        });
+}
+
+
+#ifndef _WIN32
+static void test_ssl_tcp_certificate_reload() {
+    socket_address server_address(ip_address::ip4::loopback, 10000);
+    const std::string message = "hello world!";
+    static constexpr size_t connection_count = 3;
+
+    test("ssl tcp certificate reload", [&]() {
+        ssl::tcp::server_context server_context("netlib.pem", "netlib.key");
+
+        std::thread server_thread([&]() {
+            try {
+                ssl::tcp::server_socket server(server_context, server_address);
+                for (size_t i = 0; i < connection_count; ++i) {
+                    socket_address client_address;
+                    std::shared_ptr<ssl::tcp::client_socket> client_socket = server.accept(client_address);
+                    std::vector<char> buffer;
+                    client_socket->receive(buffer);
+                    client_socket->send(buffer);
+                }
+            }
+            catch (const std::exception& ex) {
+                fail_test_with_exception(ex);
+            }
+            });
+
+        std::thread client_thread([&]() {
+            try {
+                ssl::tcp::client_context client_context("netlib.pem", "netlib.key");
+                for (size_t i = 0; i < connection_count; ++i) {
+                    ssl::tcp::client_socket client_socket(client_context, {}, server_address);
+
+                    //the connection keeps its certificate
+                    if (i == 1) {
+                        server_context.load_certificate("netlib.pem", "netlib.key");
+                    }
+
+                    std::vector<char> buffer(message.begin(), message.end());
+                    client_socket.send(buffer);
+                    client_socket.receive(buffer);
+                    check(std::string(buffer.begin(), buffer.end()) == message);
+                }
+
+                //invalid files do not replace the certificate
+                bool failed = false;
+                try {
+                    server_context.load_certificate("netlib.pem", "netlib.pem");
+                }
+                catch (const ssl::error&) {
+                    failed = true;
+                }
+                check(failed);
+            }
+            catch (const std::exception& ex) {
+                fail_test_with_exception(ex);
+            }
+            });
+
+        server_thread.join();
+        client_thread.join();
+        });
+}
+
+
+static void test_ssl_tcp_kernel_tls() {
+    socket_address server_address(ip_address::ip4::loopback, 10000);
+
+    test("ssl tcp kernel tls", [&]() {
+        //file to send
+        std::vector<char> data(50000);
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = static_cast<char>(i);
+        }
+        FILE* file = tmpfile();
+        check(fwrite(data.data(), 1, data.size(), file) == data.size());
+        fflush(file);
+
+        std::thread server_thread([&]() {
+            try {
+                ssl::tcp::server_context context("netlib.pem", "netlib.key");
+                context.set_kernel_tls(true);
+                ssl::tcp::server_socket server(context, server_address);
+                socket_address client_address;
+                std::shared_ptr<ssl::tcp::client_socket> client_socket = server.accept(client_address);
+                std::vector<char> buffer;
+                client_socket->receive(buffer);
+                check(std::equal(buffer.begin(), buffer.end(), data.begin() + 100));
+                check(buffer.size() == 40000);
+            }
+            catch (const std::exception& ex) {
+                fail_test_with_exception(ex);
+            }
+            });
+
+        std::thread client_thread([&]() {
+            try {
+                ssl::tcp::client_context context("netlib.pem", "netlib.key");
+                context.set_kernel_tls(true);
+                ssl::tcp::client_socket client_socket(context, {}, server_address);
+                client_socket.send_file(fileno(file), 100, 40000);
+            }
+            catch (const std::exception& ex) {
+                fail_test_with_exception(ex);
+            }
+            });
+
+        server_thread.join();
+        client_thread.join();
+        fclose(file);
+        });
+}
+#endif
+
+
+static void test_ssl_tcp_handshake_pipeline() {
+    socket_address server_address(ip_address::ip4::loopback, 10000);
+    static constexpr size_t client_count = 20;
+
+    test("ssl tcp handshake pipeline", [&]() {
+        ssl::tcp::server_context server_context("netlib.pem", "netlib.key");
+        auto server = std::make_shared<ssl::tcp::server_socket>(server_context, server_address);
+
+        std::mutex mutex;
+        std::vector<std::shared_ptr<ssl::tcp::client_socket>> server_client_sockets;
+        std::atomic<size_t> timeout_count{ 0 };
+
+        ssl::tcp::handshake_pipeline pipeline(server,
+            [&](const std::shared_ptr<ssl::tcp::client_socket>& s, const socket_address& addr) {
+                std::lock_guard lock(mutex);
+                server_client_sockets.push_back(s);
+            },
+            [&](const socket_address& addr, const std::exception_ptr& error) {
+                try {
+                    std::rethrow_exception(error);
+                }
+                catch (const std::system_error& ex) {
+                    if (ex.code().value() == get_connection_timeout_error_number()) {
+                        ++timeout_count;
+                    }
+                }
+                catch (...) {
+                }
+            },
+            2, std::chrono::milliseconds(200));
+
+        //a client that never starts the handshake does not stall the others
+        unencrypted::tcp::client_socket silent_client(std::nullopt, server_address);
+
+        //clients
+        ssl::tcp::client_context client_context("netlib.pem", "netlib.key");
+        std::atomic<bool> done{ false };
+        std::vector<std::thread> client_threads;
+        for (size_t i = 0; i < client_count; ++i) {
+            client_threads.emplace_back([&]() {
+                try {
+                    ssl::tcp::client_socket client_socket(client_context, {}, server_address);
+                    while (!done) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                }
+                catch (const std::exception& ex) {
+                    fail_test_with_exception(ex);
+                }
+                });
+        }
+
+        //wait for the handshakes and the timeout
+        for (size_t i = 0; i < 1000; ++i) {
+            {
+                std::lock_guard lock(mutex);
+                if (server_client_sockets.size() == client_count && timeout_count == 1) {
+                    break;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        {
+            std::lock_guard lock(mutex);
+            check(server_client_sockets.size() == client_count);
+            check(timeout_count == 1);
+            check(pipeline.pending_handshake_count() == 0);
+            server_client_sockets.clear();
+        }
+
+        done = true;
+        for (std::thread& thread : client_threads) {
+            thread.join();
+        }
+        });
+}
+
+
+static void test_ssl_udp_sockets() {
+    socket_address server_address(ip_address::ip4::loopback, 10000);
+    const std::string message = "hello world!";
+    static constexpr size_t client_count = 2;
+    static constexpr size_t message_count = 10;
+
+    test("ssl udp sockets", [&]() {
+        std::thread server_thread([&]() {
+            try {
+                ssl::udp::server_context context("netlib.pem", "netlib.key");
+                ssl::udp::server_socket server(context, server_address);
+
+                //echo the messages of each client
+                for (size_t i = 0; i < client_count; ++i) {
+                    socket_address client_address;
+                    std::shared_ptr<ssl::udp::client_socket> client_socket = server.accept(client_address);
+                    check(client_address.port() == server_address.port() + 1 + i);
+                    std::vector<char> buffer;
+                    for (size_t j = 0; j < message_count; ++j) {
+                        check(client_socket->receive(buffer));
+                        check(std::string(buffer.begin(), buffer.end()) == message);
+                        check(client_socket->send(buffer));
+                    }
+                }
+            }
+            catch (const std::exception& ex) {
+                fail_test_with_exception(ex);
+            }
+            });
+
+        std::thread client_thread([&]() {
+            try {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                ssl::udp::client_context context("netlib.pem", "netlib.key");
+                for (size_t i = 0; i < client_count; ++i) {
+                    ssl::udp::client_socket client_socket(context, socket_address(ip_address::ip4::loopback, static_cast<uint16_t>(server_address.port() + 1 + i)), server_address);
+                    std::vector<char> buffer(message.begin(), message.end());
+                    char reply[256];
+                    for (size_t j = 0; j < message_count; ++j) {
+                        check(client_socket.send(buffer));
+                        size_t size;
+                        check(client_socket.receive(reply, sizeof(reply), size));
+                        check(std::string(reply, size) == message);
+                    }
+                }
+            }
+            catch (const std::exception& ex) {
+                fail_test_with_exception(ex);
+            }
+            });
+
+        server_thread.join();
+        client_thread.join();
+        });
+}
+
+
+static void test_ssl_engine() {
+    const std::string message = "hello world!";
+
+    test("ssl engine", [&]() {
+        ssl::tcp::server_context server_context("netlib.pem", "netlib.key");
+        ssl::tcp::client_context client_context("netlib.pem", "netlib.key");
+        ssl::engine server(server_context, ssl::engine::role::server);
+        ssl::engine client(client_context, ssl::engine::role::client, "localhost");
+
+        //moves the encrypted output of one engine to the input of the other, as a transport would
+        const auto transfer = [](ssl::engine& from, ssl::engine& to) {
+            char buffer[1024];
+            while (const size_t size = from.read_output(buffer, sizeof(buffer))) {
+                to.write_input(buffer, size);
+            }
+        };
+
+        //handshake
+        for (size_t i = 0; i < 10 && !(client.is_handshake_complete() && server.is_handshake_complete()); ++i) {
+            client.handshake();
+            transfer(client, server);
+            server.handshake();
+            transfer(server, client);
+        }
+        check(client.is_handshake_complete());
+        check(server.is_handshake_complete());
+
+        //client to server
+        check(client.encrypt(message.data(), message.size()) == ssl::io_status::done);
+        check(client.pending_output_size() > message.size());
+        transfer(client, server);
+        char buffer[256];
+        size_t size;
+        check(server.decrypt(buffer, sizeof(buffer), size) == ssl::io_status::done);
+        check(std::string(buffer, size) == message);
+        check(server.decrypt(buffer, sizeof(buffer), size) == ssl::io_status::want_read);
+
+        //server to client
+        check(server.encrypt(message.data(), message.size()) == ssl::io_status::done);
+        transfer(server, client);
+        check(client.decrypt(buffer, sizeof(buffer), size) == ssl::io_status::done);
+        check(std::string(buffer, size) == message);
+
+        //shutdown
+        check(client.shutdown() == ssl::io_status::want_read);
+        transfer(client, server);
+        check(server.decrypt(buffer, sizeof(buffer), size) == ssl::io_status::closed);
+        check(server.shutdown() == ssl::io_status::done);
+        transfer(server, client);
+        check(client.shutdown() == ssl::io_status::done);
+        });
+}
+
+
 static void test_ssl_tcp_socket_polling() {
     test("ssl tcp socket polling", [&]() {
         static constexpr size_t server_socket_count = 10;
@@ -847,10 +2283,34 @@ int main() {
     //test_ip_address();
     //test_socket_address();
     //test_tcp_sockets();
+    //test_tcp_send_batch();
+    //test_tcp_socket_options();
+    //test_tcp_connect_timeout();
+    //test_connection_pool();
+    //test_tcp_buffered_receive();
     //test_tcp_socket_polling();
     //test_udp_sockets();
+    //test_udp_receive_into_buffer();
+    //test_message_buffer();
+    //test_udp_batch();
+    //test_udp_segmentation_offload();
     //test_udp_socket_polling();
+    //test_socket_poller_one_shot();
+    //test_socket_poller_callbacks();
+    //test_socket_poller_group();
+    //test_io_engine();
+    //test_async_context();
     //test_ssl_tcp_sockets();
+    //test_ssl_tcp_send_batch();
+    //test_ssl_tcp_non_blocking();
+    //test_ssl_tcp_session_resumption();
+    //test_ssl_tcp_certificate_reload();
+    //test_ssl_tcp_handshake_pipeline();
+    //test_ssl_engine();
+    //test_ssl_udp_sockets();
+    #ifndef _WIN32
+    //test_ssl_tcp_kernel_tls();
+    #endif
     //test_ssl_tcp_socket_polling();
     cleanup();
     system("pause");